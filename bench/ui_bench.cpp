@@ -0,0 +1,375 @@
+/**
+ * @file ui_bench.cpp
+ * @brief Headless render benchmark for SDLUI.
+ *
+ * Drives the launcher UI offscreen (SDL dummy video driver plus the software
+ * renderer) over generated libraries with synthetic covers, scripts scrolling
+ * through the list and grid views and typing a search query, and reports
+ * frames per second, heap allocations per frame and resident texture memory
+ * for each phase, and how quickly the menu comes back after hibernating.
+ *
+ * Usage: ui_bench [--frames N] [--sizes 100,1000,...] [--covers N] [--window]
+ */
+
+#include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "cover_preview.h"
+#include "sdl_ui.h"
+
+namespace fs = std::filesystem;
+
+// Counts every operator new in the process, including the decode workers
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+const int COVER_WIDTH = 160;
+const int COVER_HEIGHT = 224;
+const float FRAME_DT = 1.0f / 60.0f;  // Fixed step so every run scrolls the same content
+
+struct BenchConfig {
+    int framesPerPhase = 300;
+    int coverCount = 128;
+    bool window = false;
+    std::vector<size_t> sizes = {100, 1000, 10000, 100000};
+};
+
+struct PhaseResult {
+    std::string name;
+    int frames = 0;
+    double seconds = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    size_t allocations = 0;
+    size_t textureBytes = 0;
+    int drawCalls = 0;
+    double prefetchHitRate = 0.0;  ///< Covers resident when their row scrolled into view.
+};
+
+/**
+ * @brief Writes distinct striped/gradient BMP covers so decode and upload costs are realistic.
+ *
+ * Each cover's preview is computed as the IGDB client does after a download.
+ *
+ * @return One record per file with imagePath, previewHash and dominantColor set,
+ *         or an empty vector on failure.
+ */
+std::vector<GameMetadata> generateCovers(const fs::path& dir, int count) {
+    std::vector<GameMetadata> covers;
+    fs::create_directories(dir);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, COVER_WIDTH, COVER_HEIGHT, 24,
+                                                          SDL_PIXELFORMAT_RGB24);
+    if (!surface) {
+        std::cerr << "Failed to create cover surface: " << SDL_GetError() << std::endl;
+        return covers;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        fs::path path = dir / ("cover_" + std::to_string(i) + ".bmp");
+        if (!fs::exists(path)) {
+            Uint8 hue = static_cast<Uint8>(i * 37);
+            for (int y = 0; y < COVER_HEIGHT; ++y) {
+                Uint8* row = static_cast<Uint8*>(surface->pixels) + y * surface->pitch;
+                for (int x = 0; x < COVER_WIDTH; ++x) {
+                    bool stripe = ((x + y + i * 3) / 12) % 2 == 0;
+                    row[x * 3 + 0] = static_cast<Uint8>(hue + y);
+                    row[x * 3 + 1] = static_cast<Uint8>(stripe ? 200 : x);
+                    row[x * 3 + 2] = static_cast<Uint8>(255 - hue);
+                }
+            }
+            if (SDL_SaveBMP(surface, path.string().c_str()) != 0) {
+                std::cerr << "Failed to write " << path << ": " << SDL_GetError() << std::endl;
+                break;
+            }
+        }
+        GameMetadata cover;
+        cover.imagePath = path.string();
+        CoverPreview::compute(cover.imagePath, cover.previewHash, cover.dominantColor);
+        covers.push_back(std::move(cover));
+    }
+
+    SDL_FreeSurface(surface);
+    return covers;
+}
+
+/**
+ * @brief Builds a deterministic library; covers are shared round-robin across entries.
+ */
+std::vector<GameMetadata> generateLibrary(size_t count, const std::vector<GameMetadata>& covers) {
+    static const char* WORDS[] = {
+        "Super", "Mega", "Dragon", "Quest", "Ninja", "Castle", "Star", "Force", "Legend",
+        "Shadow", "Turbo", "Galaxy", "Kid", "Blaster", "Knight", "Racer", "Island", "Metal",
+        "Crystal", "Warrior", "Adventure", "Ghost", "Rocket", "Tower", "Thunder", "Zone"
+    };
+    static const char* PUBLISHERS[] = {
+        "Nintendo", "Capcom", "Konami", "Namco", "Hudson Soft", "Taito", "Sunsoft", "Enix"
+    };
+    static const char* GENRES[] = {
+        "Platform", "Action", "Role-playing", "Shooter", "Puzzle", "Racing", "Sports"
+    };
+    const size_t wordCount = sizeof(WORDS) / sizeof(WORDS[0]);
+
+    std::mt19937 rng(1985);
+    std::uniform_int_distribution<size_t> word(0, wordCount - 1);
+
+    std::vector<GameMetadata> games;
+    games.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        GameMetadata game;
+        game.title = std::string(WORDS[word(rng)]) + " " + WORDS[word(rng)] + " " + std::to_string(i + 1);
+        game.filename = game.title + ".nes";
+
+        std::ostringstream description;
+        int sentenceWords = 30 + static_cast<int>(rng() % 40);
+        for (int w = 0; w < sentenceWords; ++w) {
+            description << (w ? " " : "") << WORDS[word(rng)];
+        }
+        description << ".";
+        game.description = description.str();
+
+        game.releaseYear = std::to_string(1983 + rng() % 12);
+        game.publisher = PUBLISHERS[rng() % (sizeof(PUBLISHERS) / sizeof(PUBLISHERS[0]))];
+        game.genre = GENRES[rng() % (sizeof(GENRES) / sizeof(GENRES[0]))];
+        if (!covers.empty()) {
+            const GameMetadata& cover = covers[i % covers.size()];
+            game.imagePath = cover.imagePath;
+            game.previewHash = cover.previewHash;
+            game.dominantColor = cover.dominantColor;
+        }
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+void pushKey(SDL_Keycode key, bool down) {
+    SDL_Event event{};
+    event.type = down ? SDL_KEYDOWN : SDL_KEYUP;
+    event.key.state = down ? SDL_PRESSED : SDL_RELEASED;
+    event.key.keysym.sym = key;
+    SDL_PushEvent(&event);
+}
+
+void pushWheel(int y) {
+    SDL_Event event{};
+    event.type = SDL_MOUSEWHEEL;
+    event.wheel.y = y;
+    SDL_PushEvent(&event);
+}
+
+void pushText(char c) {
+    SDL_Event event{};
+    event.type = SDL_TEXTINPUT;
+    event.text.text[0] = c;
+    SDL_PushEvent(&event);
+}
+
+double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+/**
+ * @brief Runs one scripted phase; script(frame) injects input before each frame.
+ */
+PhaseResult runPhase(SDLUI& ui, const std::string& name, int frames,
+                     const std::function<void(int)>& script) {
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+
+    PhaseResult result;
+    result.name = name;
+
+    const PrefetchStats prefetchBefore = ui.getPrefetchStats();
+    size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    Uint64 phaseStart = SDL_GetPerformanceCounter();
+    int drawCalls = 0;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        script(frame);
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (!ui.runFrame(FRAME_DT)) {
+            break;
+        }
+        frameMs.push_back((SDL_GetPerformanceCounter() - start) * 1000.0 / frequency);
+        drawCalls += ui.getLastFrameRenderStats().drawCalls;
+        ++result.frames;
+    }
+
+    result.seconds = (SDL_GetPerformanceCounter() - phaseStart) / frequency;
+    result.allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    result.p50Ms = percentile(frameMs, 0.50);
+    result.p95Ms = percentile(frameMs, 0.95);
+    result.textureBytes = ui.getCoverCacheStats().residentBytes + ui.getTextCacheStats().residentBytes +
+                         ui.getRowCacheStats().residentBytes;
+    result.drawCalls = result.frames ? drawCalls / result.frames : 0;
+
+    const PrefetchStats prefetchAfter = ui.getPrefetchStats();
+    size_t arrivals = prefetchAfter.arrivals - prefetchBefore.arrivals;
+    size_t ready = prefetchAfter.readyOnArrival - prefetchBefore.readyOnArrival;
+    result.prefetchHitRate = arrivals ? static_cast<double>(ready) / arrivals : 1.0;
+    return result;
+}
+
+void printHeader() {
+    std::cout << std::left << std::setw(8) << "games" << std::setw(12) << "phase"
+              << std::right << std::setw(8) << "frames" << std::setw(10) << "fps"
+              << std::setw(9) << "p50 ms" << std::setw(9) << "p95 ms"
+              << std::setw(14) << "allocs/frame" << std::setw(10) << "tex MiB"
+              << std::setw(13) << "draws/frame" << std::setw(10) << "prefetch" << std::endl;
+}
+
+void printResult(size_t games, const PhaseResult& r) {
+    double fps = r.seconds > 0.0 ? r.frames / r.seconds : 0.0;
+    double allocs = r.frames ? static_cast<double>(r.allocations) / r.frames : 0.0;
+    std::cout << std::left << std::setw(8) << games << std::setw(12) << r.name
+              << std::right << std::setw(8) << r.frames
+              << std::fixed << std::setprecision(1) << std::setw(10) << fps
+              << std::setprecision(2) << std::setw(9) << r.p50Ms << std::setw(9) << r.p95Ms
+              << std::setprecision(1) << std::setw(14) << allocs
+              << std::setw(10) << r.textureBytes / (1024.0 * 1024.0)
+              << std::setw(13) << r.drawCalls
+              << std::setw(9) << r.prefetchHitRate * 100.0 << "%" << std::endl;
+}
+
+bool parseArgs(int argc, char* argv[], BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--window") {
+            config.window = true;
+        } else if (arg == "--frames" && i + 1 < argc) {
+            config.framesPerPhase = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--covers" && i + 1 < argc) {
+            config.coverCount = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            config.sizes.clear();
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                size_t size = std::strtoull(item.c_str(), nullptr, 10);
+                if (size > 0) {
+                    config.sizes.push_back(size);
+                }
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--frames N] [--sizes 100,1000,...] [--covers N] [--window]" << std::endl;
+            return false;
+        }
+    }
+    return !config.sizes.empty();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    // No display on build machines; an explicit SDL_VIDEODRIVER still wins
+    if (!config.window) {
+        setenv("SDL_VIDEODRIVER", "dummy", 0);
+    }
+
+    SDLUI ui;
+    if (!ui.init(!config.window)) {
+        std::cerr << "Failed to initialize UI" << std::endl;
+        return 1;
+    }
+
+    std::vector<GameMetadata> covers = generateCovers(fs::temp_directory_path() / "retro_ui_bench",
+                                                     config.coverCount);
+    const int frames = config.framesPerPhase;
+
+    printHeader();
+    for (size_t size : config.sizes) {
+        std::vector<GameMetadata> library = generateLibrary(size, covers);
+        size_t metadataBytes = 0;
+        for (const GameMetadata& game : library) {
+            metadataBytes += GameCatalog::metadataBytes(game);
+        }
+        ui.setGameLibrary(std::move(library));
+        std::cout << "# " << size << " games: catalog " << ui.getCatalog().memoryBytes() / size
+                  << " bytes/game, GameMetadata " << metadataBytes / size << " bytes/game" << std::endl;
+
+        printResult(size, runPhase(ui, "list-hold", frames, [&](int frame) {
+            if (frame == 0) pushKey(SDLK_DOWN, true);
+            if (frame == frames - 1) pushKey(SDLK_DOWN, false);
+        }));
+        printResult(size, runPhase(ui, "list-wheel", frames, [](int frame) {
+            if (frame % 6 == 0) pushWheel(-1);
+        }));
+        printResult(size, runPhase(ui, "grid-hold", frames, [&](int frame) {
+            if (frame == 0) {
+                pushKey(SDLK_TAB, true);
+                pushKey(SDLK_DOWN, true);
+            }
+            if (frame == frames - 1) pushKey(SDLK_DOWN, false);
+        }));
+        printResult(size, runPhase(ui, "grid-step", frames, [&](int frame) {
+            // Single steps that rarely scroll: software rendering redraws only two tiles
+            if (frame % 8 == 0) pushKey(SDLK_RIGHT, true);
+            if (frame % 8 == 1) pushKey(SDLK_RIGHT, false);
+        }));
+        printResult(size, runPhase(ui, "grid-zoom", frames, [&](int frame) {
+            if (frame % 10 == 0) pushKey(frame < frames / 2 ? SDLK_MINUS : SDLK_PLUS, true);
+            if (frame == frames - 1) pushKey(SDLK_TAB, true);  // Back to the list for the next size
+        }));
+        printResult(size, runPhase(ui, "search", frames, [&](int frame) {
+            // Type a query one character every few frames, then erase it again
+            static const std::string QUERY = "dragon quest 7";
+            int step = frame / 4;
+            if (frame % 4 != 0) return;
+            if (step < static_cast<int>(QUERY.size())) {
+                pushText(QUERY[step]);
+            } else if (step < static_cast<int>(2 * QUERY.size())) {
+                pushKey(SDLK_BACKSPACE, true);
+            }
+        }));
+
+        // A game that exits at once: hibernate, then come back to the live menu
+        ui.notifyGameExited();
+        ui.waitForGame("ui_bench");
+        const HibernationStats& idle = ui.getLastHibernation();
+        std::cout << "# resume: menu back in " << std::setprecision(1) << idle.resumeMillis << " ms, RSS "
+                  << idle.residentDuring / (1024 * 1024) << " MiB hibernated (was "
+                  << idle.residentBefore / (1024 * 1024) << " MiB)" << std::endl;
+    }
+
+    ui.cleanup();
+    return 0;
+}
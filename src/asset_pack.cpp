@@ -0,0 +1,232 @@
+/**
+ * @file asset_pack.cpp
+ * @brief Implements AssetPack loading (memory-mapped) and writing.
+ */
+
+#include "asset_pack.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::AssetPack() : mapping(nullptr), mappingSize(0), records(nullptr), recordCount(0) {}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+/**
+ * @brief Returns the path of the pack next to the running executable.
+ */
+std::string AssetPack::defaultPath() {
+    std::string path;
+    if (char* base = SDL_GetBasePath()) {
+        path = base;
+        SDL_free(base);
+    }
+    return path + FILE_NAME;
+}
+
+/**
+ * @brief Maps a pack file and validates its table of contents.
+ */
+bool AssetPack::open(const std::string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Failed to map asset pack " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    mapping = static_cast<const uint8_t*>(mapped);
+    mappingSize = static_cast<size_t>(info.st_size);
+#else
+    size_t size = 0;
+    void* loaded = SDL_LoadFile(path.c_str(), &size);
+    if (!loaded) {
+        return false;
+    }
+    mapping = static_cast<const uint8_t*>(loaded);
+    mappingSize = size;
+#endif
+
+    Header header = {};
+    if (mappingSize >= sizeof(Header)) {
+        std::memcpy(&header, mapping, sizeof(header));
+    }
+    size_t tableEnd = sizeof(Header) + static_cast<size_t>(header.entryCount) * sizeof(EntryRecord);
+    if (mappingSize < sizeof(Header) || header.magic != MAGIC || header.version != VERSION || tableEnd > mappingSize) {
+        std::cerr << "Ignoring invalid asset pack " << path << std::endl;
+        close();
+        return false;
+    }
+
+    records = reinterpret_cast<const EntryRecord*>(mapping + sizeof(Header));
+    recordCount = header.entryCount;
+    for (uint32_t i = 0; i < recordCount; ++i) {
+        const EntryRecord& record = records[i];
+        if (record.offset > mappingSize || record.size > mappingSize - record.offset ||
+            std::memchr(record.name, '\0', NAME_SIZE) == nullptr) {
+            std::cerr << "Ignoring corrupt asset pack " << path << std::endl;
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the pack.
+ */
+void AssetPack::close() {
+    if (mapping) {
+#ifndef _WIN32
+        munmap(const_cast<uint8_t*>(mapping), mappingSize);
+#else
+        SDL_free(const_cast<uint8_t*>(mapping));
+#endif
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    records = nullptr;
+    recordCount = 0;
+}
+
+/**
+ * @brief Returns an entry's bytes, or an empty blob if there is no such entry.
+ *
+ * Packs hold a handful of entries, so a linear scan of the table is enough.
+ */
+AssetPack::Blob AssetPack::find(const std::string& name) const {
+    Blob blob;
+    for (uint32_t i = 0; i < recordCount; ++i) {
+        if (name == records[i].name) {
+            blob.data = mapping + records[i].offset;
+            blob.size = static_cast<size_t>(records[i].size);
+            break;
+        }
+    }
+    return blob;
+}
+
+/**
+ * @brief Returns an SDL_RWops reading an entry in place, or nullptr.
+ */
+SDL_RWops* AssetPack::openEntry(const std::string& name) const {
+    Blob blob = find(name);
+    if (!blob) {
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(blob.data, static_cast<int>(blob.size));
+}
+
+/**
+ * @brief Copies an image entry into a new ARGB8888 surface.
+ */
+SDL_Surface* AssetPack::loadImage(const std::string& name) const {
+    Blob blob = find(name);
+    if (blob.size < sizeof(ImageHeader)) {
+        return nullptr;
+    }
+
+    ImageHeader image;
+    std::memcpy(&image, blob.data, sizeof(image));
+    if (image.format != SDL_PIXELFORMAT_ARGB8888 || image.pitch < image.width * 4 ||
+        static_cast<uint64_t>(image.pitch) * image.height > blob.size - sizeof(ImageHeader)) {
+        std::cerr << "Asset " << name << " is not an ARGB8888 image" << std::endl;
+        return nullptr;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(image.width),
+                                                          static_cast<int>(image.height), 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return nullptr;
+    }
+    const uint8_t* src = blob.data + sizeof(ImageHeader);
+    uint8_t* dst = static_cast<uint8_t*>(surface->pixels);
+    for (uint32_t y = 0; y < image.height; ++y) {
+        std::memcpy(dst + y * surface->pitch, src + y * image.pitch, image.width * 4);
+    }
+    return surface;
+}
+
+/**
+ * @brief Returns true if an image path names a pack entry.
+ */
+bool AssetPack::isAssetUri(const std::string& path) {
+    return path.compare(0, std::strlen(URI_PREFIX), URI_PREFIX) == 0;
+}
+
+/**
+ * @brief Encodes an ARGB8888 surface as an image entry.
+ */
+std::vector<uint8_t> AssetPack::encodeImage(const SDL_Surface* surface) {
+    ImageHeader image;
+    image.width = static_cast<uint32_t>(surface->w);
+    image.height = static_cast<uint32_t>(surface->h);
+    image.pitch = image.width * 4;
+    image.format = SDL_PIXELFORMAT_ARGB8888;
+
+    std::vector<uint8_t> data(sizeof(ImageHeader) + static_cast<size_t>(image.pitch) * image.height);
+    std::memcpy(data.data(), &image, sizeof(image));
+    const uint8_t* src = static_cast<const uint8_t*>(surface->pixels);
+    for (uint32_t y = 0; y < image.height; ++y) {
+        std::memcpy(data.data() + sizeof(ImageHeader) + y * image.pitch, src + y * surface->pitch, image.pitch);
+    }
+    return data;
+}
+
+/**
+ * @brief Writes a pack file.
+ */
+bool AssetPack::write(const std::string& path, const std::vector<Entry>& entries) {
+    auto align = [](uint64_t offset) { return (offset + ALIGNMENT - 1) & ~static_cast<uint64_t>(ALIGNMENT - 1); };
+
+    Header header = {MAGIC, VERSION, static_cast<uint32_t>(entries.size()), 0};
+    std::vector<EntryRecord> table(entries.size());
+    uint64_t offset = align(sizeof(Header) + entries.size() * sizeof(EntryRecord));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].name.size() >= NAME_SIZE) {
+            std::cerr << "Asset name too long: " << entries[i].name << std::endl;
+            return false;
+        }
+        std::memset(table[i].name, 0, NAME_SIZE);
+        std::memcpy(table[i].name, entries[i].name.data(), entries[i].name.size());
+        table[i].offset = offset;
+        table[i].size = entries[i].data.size();
+        offset = align(offset + entries[i].data.size());
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to create asset pack " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(EntryRecord)));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        // Pad up to the entry's aligned offset
+        static const char zeros[ALIGNMENT] = {};
+        out.write(zeros, static_cast<std::streamsize>(table[i].offset - static_cast<uint64_t>(out.tellp())));
+        out.write(reinterpret_cast<const char*>(entries[i].data.data()), static_cast<std::streamsize>(entries[i].data.size()));
+    }
+    return static_cast<bool>(out);
+}
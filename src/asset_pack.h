@@ -0,0 +1,147 @@
+/**
+ * @file asset_pack.h
+ * @brief Declares AssetPack, a read-only bundle of the launcher's built-in assets.
+ *
+ * The font, the placeholder cover and glyph atlases pre-rasterized at the
+ * default font sizes are packed at build time into one file installed next
+ * to the executable. At startup the file is memory-mapped, so nothing is
+ * probed on disk and entries are read in place without copying.
+ *
+ * Layout (native byte order, every entry 16-byte aligned):
+ *   Header, then Header::entryCount EntryRecords, then the entry data.
+ * Image entries start with an ImageHeader followed by ARGB8888 rows.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class AssetPack
+ * @brief Maps an asset pack and looks up its entries by name.
+ */
+class AssetPack {
+public:
+    /// File name of the pack, looked up in the executable's directory
+    static constexpr const char* FILE_NAME = "retro_assets.pak";
+
+    /// Prefix of image paths that refer to pack entries rather than files
+    static constexpr const char* URI_PREFIX = "asset:";
+
+    /// Well-known entries
+    static constexpr const char* FONT = "font";
+    static constexpr const char* PLACEHOLDER = "images/not_found";
+
+    /// Image path of the placeholder cover, for games without art
+    static constexpr const char* PLACEHOLDER_URI = "asset:images/not_found";
+
+    /**
+     * @brief A view of one entry's bytes inside the mapping.
+     */
+    struct Blob {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    /**
+     * @brief An entry to be written by write().
+     */
+    struct Entry {
+        std::string name;
+        std::vector<uint8_t> data;
+    };
+
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * @brief Returns the path of the pack next to the running executable.
+     */
+    static std::string defaultPath();
+
+    /**
+     * @brief Maps a pack file and validates its table of contents.
+     * @param path Path of the pack.
+     * @return false if the file is missing or malformed; the pack stays closed.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the pack. Blobs and surfaces obtained from it become invalid.
+     */
+    void close();
+
+    bool isOpen() const { return mapping != nullptr; }
+
+    /**
+     * @brief Returns an entry's bytes, or an empty blob if there is no such entry.
+     */
+    Blob find(const std::string& name) const;
+
+    /**
+     * @brief Returns an SDL_RWops reading an entry in place, or nullptr.
+     *
+     * The caller closes it; the pack must stay open while it is used.
+     */
+    SDL_RWops* openEntry(const std::string& name) const;
+
+    /**
+     * @brief Copies an image entry into a new ARGB8888 surface.
+     * @return The surface (owned by the caller), or nullptr if the entry is missing or not an image.
+     */
+    SDL_Surface* loadImage(const std::string& name) const;
+
+    /**
+     * @brief Returns true if an image path names a pack entry (see URI_PREFIX).
+     */
+    static bool isAssetUri(const std::string& path);
+
+    /**
+     * @brief Encodes an ARGB8888 surface as an image entry.
+     */
+    static std::vector<uint8_t> encodeImage(const SDL_Surface* surface);
+
+    /**
+     * @brief Writes a pack file.
+     * @return false if the file could not be written.
+     */
+    static bool write(const std::string& path, const std::vector<Entry>& entries);
+
+private:
+    static const uint32_t MAGIC = 0x4b415052;  // "RPAK"
+    static const uint32_t VERSION = 1;
+    static const size_t NAME_SIZE = 48;
+    static const size_t ALIGNMENT = 16;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+    };
+
+    struct EntryRecord {
+        char name[NAME_SIZE];
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct ImageHeader {
+        uint32_t width;
+        uint32_t height;
+        uint32_t pitch;
+        uint32_t format;
+    };
+
+    const uint8_t* mapping;
+    size_t mappingSize;
+    const EntryRecord* records;
+    uint32_t recordCount;
+};
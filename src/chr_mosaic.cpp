@@ -0,0 +1,204 @@
+/**
+ * @file chr_mosaic.cpp
+ * @brief Implements the iNES parsing, SIMD tile decoding and caching of ChrMosaic.
+ */
+
+#include "chr_mosaic.h"
+#include "cover_preview.h"
+#include <SDL_image.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RETRO_HAVE_SSE2 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const size_t INES_HEADER_BYTES = 16;
+const size_t INES_TRAINER_BYTES = 512;
+const size_t PRG_UNIT_BYTES = 16 * 1024;
+const size_t CHR_UNIT_BYTES = 8 * 1024;
+
+/// The default palette: NES colors $0F, $12, $21 and $30
+const Uint32 PALETTE[4] = {0xFF000000u, 0xFF0058F8u, 0xFF3CBCFCu, 0xFFFCFCFCu};
+
+/**
+ * @brief Returns true if every pixel of a tile has the same value, as in padding and blank tiles.
+ */
+bool isSolidTile(const uint8_t* tile) {
+    for (int plane = 0; plane < 2; ++plane) {
+        const uint8_t* bits = tile + plane * 8;
+        if ((bits[0] != 0x00 && bits[0] != 0xFF) || std::any_of(bits, bits + 8, [&](uint8_t b) { return b != bits[0]; })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Returns the mosaic of a ROM, generating it if the cached one is missing or stale.
+ */
+bool ChrMosaic::generate(const std::string& romPath, const std::string& outputPath, std::string& previewHash,
+                         uint32_t& dominantColor) {
+    std::error_code romError, cacheError;
+    const auto romTime = fs::last_write_time(romPath, romError);
+    const auto cacheTime = fs::last_write_time(outputPath, cacheError);
+    if (!romError && !cacheError && cacheTime >= romTime) {
+        return CoverPreview::compute(outputPath, previewHash, dominantColor);
+    }
+
+    SDL_Surface* mosaic = render(romPath);
+    if (!mosaic) {
+        return false;
+    }
+
+    std::error_code dirError;
+    fs::create_directories(fs::path(outputPath).parent_path(), dirError);
+    bool saved = IMG_SavePNG(mosaic, outputPath.c_str()) == 0;
+    if (saved) {
+        CoverPreview::compute(mosaic, previewHash, dominantColor);
+    } else {
+        std::cerr << "Failed to write tile mosaic " << outputPath << ": " << IMG_GetError() << std::endl;
+    }
+    SDL_FreeSurface(mosaic);
+    return saved;
+}
+
+/**
+ * @brief Renders the mosaic of a ROM.
+ */
+SDL_Surface* ChrMosaic::render(const std::string& romPath) {
+    std::ifstream in(romPath, std::ios::binary);
+    uint8_t header[INES_HEADER_BYTES];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != 'N' || header[1] != 'E' ||
+        header[2] != 'S' || header[3] != 0x1A) {
+        std::cerr << "Not an iNES ROM: " << romPath << std::endl;
+        return nullptr;
+    }
+
+    size_t prgUnits = header[4];
+    size_t chrUnits = header[5];
+    if ((header[7] & 0x0C) == 0x08 && (header[9] & 0x0F) != 0x0F && (header[9] >> 4) != 0x0F) {
+        // NES 2.0 keeps the high bits of both sizes in byte 9 (0xF selects an exponent form, not used here)
+        prgUnits |= static_cast<size_t>(header[9] & 0x0F) << 8;
+        chrUnits |= static_cast<size_t>(header[9] >> 4) << 8;
+    }
+
+    // CHR-RAM games have no CHR-ROM; their tiles are somewhere in PRG-ROM
+    size_t offset = INES_HEADER_BYTES + ((header[6] & 0x04) ? INES_TRAINER_BYTES : 0);
+    size_t length = chrUnits * CHR_UNIT_BYTES;
+    if (length > 0) {
+        offset += prgUnits * PRG_UNIT_BYTES;
+    } else {
+        length = prgUnits * PRG_UNIT_BYTES;
+    }
+
+    std::vector<uint8_t> data(std::min(length, MAX_SCAN_BYTES));
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    data.resize(static_cast<size_t>(std::max<std::streamsize>(in.gcount(), 0)) / TILE_BYTES * TILE_BYTES);
+
+    // Distinct, non-blank tiles in ROM order: fonts and sprites rather than padding
+    const size_t maxTiles = static_cast<size_t>(GRID_TILES) * GRID_TILES;
+    std::vector<const uint8_t*> tiles;
+    std::unordered_set<std::string_view> seen;
+    for (size_t i = 0; i < data.size() && tiles.size() < maxTiles; i += TILE_BYTES) {
+        const uint8_t* tile = data.data() + i;
+        if (!isSolidTile(tile) && seen.insert(std::string_view(reinterpret_cast<const char*>(tile), TILE_BYTES)).second) {
+            tiles.push_back(tile);
+        }
+    }
+    if (tiles.empty()) {
+        std::cerr << "No tiles to build a mosaic from in " << romPath << std::endl;
+        return nullptr;
+    }
+
+    int side = 1;
+    while (static_cast<size_t>((side + 1) * (side + 1)) <= tiles.size()) {
+        side++;
+    }
+
+    SDL_Surface* surface =
+        SDL_CreateRGBSurfaceWithFormat(0, side * TILE_SIZE, side * TILE_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        std::cerr << "Failed to create mosaic surface: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    const int pitch = surface->pitch / static_cast<int>(sizeof(Uint32));
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    for (int i = 0; i < side * side; ++i) {
+        decodeTile(tiles[i], PALETTE, pixels + (i / side) * TILE_SIZE * pitch + (i % side) * TILE_SIZE, pitch);
+    }
+    return surface;
+}
+
+/**
+ * @brief Decodes one 2bpp planar tile into ARGB8888 pixels.
+ *
+ * Bit 7 of each plane byte is the leftmost pixel. The SSE2 path expands
+ * two rows at a time: each plane byte is broadcast across eight lanes,
+ * tested against one bit per lane, and the resulting masks select the
+ * palette color of every pixel.
+ */
+void ChrMosaic::decodeTile(const uint8_t* tile, const Uint32 palette[4], Uint32* dst, int pitch) {
+#ifdef RETRO_HAVE_SSE2
+    const __m128i bits = _mm_setr_epi8(static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                       static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i colors[4] = {_mm_set1_epi32(static_cast<int>(palette[0])), _mm_set1_epi32(static_cast<int>(palette[1])),
+                               _mm_set1_epi32(static_cast<int>(palette[2])), _mm_set1_epi32(static_cast<int>(palette[3]))};
+
+    const __m128i planes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tile));
+    const __m128i plane0 = _mm_unpacklo_epi8(planes, planes);  // Rows 0-7 of plane 0, each byte twice
+    const __m128i plane1 = _mm_unpackhi_epi8(planes, planes);
+    const __m128i quads0[2] = {_mm_unpacklo_epi16(plane0, plane0), _mm_unpackhi_epi16(plane0, plane0)};
+    const __m128i quads1[2] = {_mm_unpacklo_epi16(plane1, plane1), _mm_unpackhi_epi16(plane1, plane1)};
+
+    for (int pair = 0; pair < 4; ++pair) {
+        // Rows 2 * pair and 2 * pair + 1, each plane byte spread over eight lanes
+        const __m128i q0 = quads0[pair / 2];
+        const __m128i q1 = quads1[pair / 2];
+        const __m128i rows0 = (pair & 1) ? _mm_unpackhi_epi32(q0, q0) : _mm_unpacklo_epi32(q0, q0);
+        const __m128i rows1 = (pair & 1) ? _mm_unpackhi_epi32(q1, q1) : _mm_unpacklo_epi32(q1, q1);
+        const __m128i set0 = _mm_cmpeq_epi8(_mm_and_si128(rows0, bits), bits);
+        const __m128i set1 = _mm_cmpeq_epi8(_mm_and_si128(rows1, bits), bits);
+        const __m128i values = _mm_or_si128(_mm_and_si128(set0, _mm_set1_epi8(1)), _mm_and_si128(set1, _mm_set1_epi8(2)));
+
+        const __m128i wordsLo = _mm_unpacklo_epi8(values, zero);
+        const __m128i wordsHi = _mm_unpackhi_epi8(values, zero);
+        const __m128i quads[4] = {_mm_unpacklo_epi16(wordsLo, zero), _mm_unpackhi_epi16(wordsLo, zero),
+                                  _mm_unpacklo_epi16(wordsHi, zero), _mm_unpackhi_epi16(wordsHi, zero)};
+        for (int q = 0; q < 4; ++q) {
+            __m128i out = zero;
+            for (int value = 0; value < 4; ++value) {
+                __m128i match = _mm_cmpeq_epi32(quads[q], _mm_set1_epi32(value));
+                out = _mm_or_si128(out, _mm_and_si128(match, colors[value]));
+            }
+            Uint32* row = dst + (pair * 2 + q / 2) * pitch + (q % 2) * 4;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row), out);
+        }
+    }
+#else
+    for (int y = 0; y < TILE_SIZE; ++y) {
+        const uint8_t low = tile[y];
+        const uint8_t high = tile[y + 8];
+        Uint32* row = dst + y * pitch;
+        for (int x = 0; x < TILE_SIZE; ++x) {
+            const int shift = 7 - x;
+            row[x] = palette[((low >> shift) & 1) | (((high >> shift) & 1) << 1)];
+        }
+    }
+#endif
+}
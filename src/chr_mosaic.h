@@ -0,0 +1,64 @@
+/**
+ * @file chr_mosaic.h
+ * @brief Declares ChrMosaic, which builds fallback cover art from a ROM's own graphics.
+ *
+ * Games IGDB does not know, such as hacks and homebrew, would otherwise all
+ * share the same placeholder. NES graphics are stored as 8x8 tiles of two
+ * bit planes in the cartridge's CHR-ROM, so a square mosaic of a game's
+ * distinct tiles, drawn with a fixed palette, gives each of them a
+ * recognizable cover without any network access. Mosaics are written next
+ * to the downloaded covers and reused until the ROM changes.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class ChrMosaic
+ * @brief Decodes NES pattern tables into a tile mosaic thumbnail.
+ */
+class ChrMosaic {
+public:
+    static const int TILE_SIZE = 8;
+    static const int TILE_BYTES = 16;  ///< 8 bytes of bit plane 0, then 8 bytes of bit plane 1
+    static const int GRID_TILES = 16;  ///< Tiles per side of a full mosaic
+
+    /**
+     * @brief Returns the mosaic of a ROM, generating it if the cached one is missing or stale.
+     * @param romPath The iNES ROM file.
+     * @param outputPath Where the PNG mosaic is cached.
+     * @param previewHash Receives the mosaic's BlurHash preview.
+     * @param dominantColor Receives the mosaic's dominant color.
+     * @return false if the ROM has no usable tiles or the mosaic could not be written.
+     */
+    static bool generate(const std::string& romPath, const std::string& outputPath, std::string& previewHash,
+                         uint32_t& dominantColor);
+
+    /**
+     * @brief Renders the mosaic of a ROM.
+     *
+     * Tiles are taken from CHR-ROM in order, skipping blank ones and
+     * repeats, and laid out in the largest square grid they fill, up to
+     * GRID_TILES a side. Games with CHR-RAM keep their tiles in PRG-ROM,
+     * which is scanned instead.
+     *
+     * @param romPath The iNES ROM file.
+     * @return An ARGB8888 surface owned by the caller, or nullptr if the ROM is unreadable or has no tiles.
+     */
+    static SDL_Surface* render(const std::string& romPath);
+
+    /**
+     * @brief Decodes one 2bpp planar tile into ARGB8888 pixels.
+     * @param tile TILE_BYTES bytes of pattern data.
+     * @param palette Colors of the four pixel values.
+     * @param dst Top-left pixel of the destination.
+     * @param pitch Destination row length in pixels.
+     */
+    static void decodeTile(const uint8_t* tile, const Uint32 palette[4], Uint32* dst, int pitch);
+
+private:
+    /// Pattern data read per ROM: 2048 tiles, far more than a mosaic can show
+    static const size_t MAX_SCAN_BYTES = 32 * 1024;
+};
@@ -0,0 +1,373 @@
+/**
+ * @file cover_atlas.cpp
+ * @brief Implements the CoverAtlas texture atlas and its batched draw path.
+ */
+
+#include "cover_atlas.h"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief Constructs an empty atlas. Pages are created on demand.
+ * @param cellSize Edge length of each square cover cell in pixels.
+ * @param pageSize Edge length of each atlas page in pixels.
+ * @param maxPages Maximum number of pages to allocate.
+ */
+CoverAtlas::CoverAtlas(int cellSize, int pageSize, int maxPages)
+    : renderer(nullptr), compositor(nullptr), cellSize(cellSize), pageSize(pageSize),
+      cellsPerRow(pageSize / cellSize), maxPages(maxPages), screenPages(maxPages), frame(1) {
+    stats.budgetBytes = static_cast<size_t>(maxPages) * pageBytes();
+}
+
+/**
+ * @brief Destroys all pages.
+ */
+CoverAtlas::~CoverAtlas() {
+    clear();
+}
+
+/**
+ * @brief Sets the renderer used to create pages.
+ */
+void CoverAtlas::setRenderer(SDL_Renderer* renderer, SoftwareCompositor* compositor) {
+    if (this->renderer != renderer || this->compositor != compositor) {
+        clear();
+        this->renderer = renderer;
+        this->compositor = compositor;
+    }
+}
+
+/**
+ * @brief Checks whether a cover is resident and marks it as used this frame.
+ * @param key The cover key.
+ * @param counted False for fallback draws that must not count as lookups.
+ * @return true if the cover can be drawn with queueDraw().
+ */
+bool CoverAtlas::touch(const std::string& key, bool counted) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        // Covers take several frames to decode; count the wait once, not once per frame
+        if (counted && missed.insert(key).second) {
+            stats.misses++;
+        }
+        return false;
+    }
+
+    Slot& slot = slots[it->second];
+    if (counted && slot.lastUsedFrame + 1 < frame) {
+        stats.hits++;  // Coming into use, not drawn again while it stays on screen
+    }
+    slot.lastUsedFrame = frame;
+    if (!slot.pinned) {
+        lru.splice(lru.begin(), lru, slot.lruPos);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns true if an insert right after this frame could find a slot.
+ */
+bool CoverAtlas::hasRoom() const {
+    return !freeSlots.empty() || static_cast<int>(pages.size()) < screenPages ||
+           (!lru.empty() && slots[lru.back()].lastUsedFrame + 1 < frame);
+}
+
+/**
+ * @brief Copies a cover into a free or evicted slot.
+ * @param key The cover key.
+ * @param surface ARGB8888 pixels of exactly cellSize x cellSize.
+ * @param pinned If true the slot is never evicted.
+ * @return true if the cover is now resident.
+ */
+bool CoverAtlas::insert(const std::string& key, SDL_Surface* surface, bool pinned) {
+    if (!renderer || !surface || surface->w != cellSize || surface->h != cellSize) {
+        return false;
+    }
+
+    auto existing = index.find(key);
+    int slotIndex = existing != index.end() ? existing->second : allocateSlot();
+    if (slotIndex < 0) {
+        return false;
+    }
+
+    Slot& slot = slots[slotIndex];
+    SDL_Rect rect = cellRect(slot.cell);
+    Page& page = pages[slot.page];
+    if (page.surface) {
+        // Software pages are copied row by row; the alpha scan lets opaque covers skip blending
+        Uint32 alpha = 0xFF000000u;
+        for (int y = 0; y < cellSize; ++y) {
+            const Uint32* in = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(surface->pixels) +
+                                                               y * surface->pitch);
+            Uint32* out = reinterpret_cast<Uint32*>(static_cast<Uint8*>(page.surface->pixels) +
+                                                    (rect.y + y) * page.surface->pitch) + rect.x;
+            for (int x = 0; x < cellSize; ++x) {
+                out[x] = in[x];
+                alpha &= in[x];
+            }
+        }
+        slot.opaque = alpha == 0xFF000000u;
+    } else if (SDL_UpdateTexture(page.texture, &rect, surface->pixels, surface->pitch) != 0) {
+        std::cerr << "Failed to upload cover to atlas! SDL Error: " << SDL_GetError() << std::endl;
+        releaseSlot(slotIndex);
+        return false;
+    }
+
+    if (existing == index.end()) {
+        slot.key = key;
+        slot.pinned = pinned;
+        index[key] = slotIndex;
+        missed.erase(key);
+        if (!pinned) {
+            lru.push_front(slotIndex);
+            slot.lruPos = lru.begin();
+        }
+    }
+    slot.lastUsedFrame = frame;
+    stats.entries = index.size();
+    return true;
+}
+
+/**
+ * @brief Queues a resident cover to be drawn in the next flush().
+ * @param key The cover key.
+ * @param dst Destination rectangle on screen.
+ * @return false if the cover is not resident.
+ */
+bool CoverAtlas::queueDraw(const std::string& key, const SDL_Rect& dst) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
+    }
+
+    const Slot& slot = slots[it->second];
+    Page& page = pages[slot.page];
+    SDL_Rect src = cellRect(slot.cell);
+    if (page.surface) {
+        page.blits.push_back({src, dst, slot.opaque});
+        return true;
+    }
+
+    // Sample texel centres so neighbouring cells never bleed in when filtering
+    float inv = 1.0f / pageSize;
+    float u0 = (src.x + 0.5f) * inv;
+    float v0 = (src.y + 0.5f) * inv;
+    float u1 = (src.x + src.w - 0.5f) * inv;
+    float v1 = (src.y + src.h - 0.5f) * inv;
+    float x0 = static_cast<float>(dst.x);
+    float y0 = static_cast<float>(dst.y);
+    float x1 = static_cast<float>(dst.x + dst.w);
+    float y1 = static_cast<float>(dst.y + dst.h);
+    SDL_Color white = {255, 255, 255, 255};
+
+    int base = static_cast<int>(page.vertices.size());
+    page.vertices.push_back({{x0, y0}, white, {u0, v0}});
+    page.vertices.push_back({{x1, y0}, white, {u1, v0}});
+    page.vertices.push_back({{x1, y1}, white, {u1, v1}});
+    page.vertices.push_back({{x0, y1}, white, {u0, v1}});
+    const int quad[6] = {0, 1, 2, 0, 2, 3};
+    for (int offset : quad) {
+        page.indices.push_back(base + offset);
+    }
+    return true;
+}
+
+/**
+ * @brief Submits every queued quad, one geometry call per page.
+ * @param renderer The renderer to draw with.
+ * @param stats Draw counters to update.
+ */
+void CoverAtlas::flush(SDL_Renderer* renderer, RenderStats& stats) {
+    if (compositor) {
+        flushSoftware(renderer, stats);
+        return;
+    }
+
+    for (auto& page : pages) {
+        if (page.indices.empty()) continue;
+
+        SDL_RenderGeometry(renderer, page.texture, page.vertices.data(), static_cast<int>(page.vertices.size()),
+                           page.indices.data(), static_cast<int>(page.indices.size()));
+        stats.drawCalls++;
+        stats.textureSwitches++;
+        stats.batchedQuads += static_cast<int>(page.indices.size() / 6);
+
+        // Keep the capacity so steady-state frames do not allocate
+        page.vertices.clear();
+        page.indices.clear();
+    }
+}
+
+/**
+ * @brief Blits every queued cover into the compositor's framebuffer.
+ *
+ * Draws already queued on the renderer (backgrounds, the selection) are
+ * flushed first so the covers land on top of them.
+ */
+void CoverAtlas::flushSoftware(SDL_Renderer* renderer, RenderStats& stats) {
+    bool flushed = false;
+    for (auto& page : pages) {
+        if (page.blits.empty()) continue;
+        if (!flushed) {
+            SDL_RenderFlush(renderer);
+            flushed = true;
+        }
+
+        for (const Blit& blit : page.blits) {
+            compositor->blitScaled(page.surface, blit.src, blit.dst, blit.opaque);
+        }
+        stats.drawCalls++;
+        stats.textureSwitches++;
+        stats.batchedQuads += static_cast<int>(page.blits.size());
+        page.blits.clear();
+    }
+}
+
+/**
+ * @brief Starts a new frame. Slots touched in the previous frame become evictable.
+ */
+void CoverAtlas::beginFrame() {
+    frame++;
+}
+
+/**
+ * @brief Changes the page limits. Shrinking below the current page count drops everything.
+ * @param maxPages Pages the atlas keeps for reuse, its share of the budget.
+ * @param screenPages Pages it may grow to past maxPages when every slot holds a cover on screen.
+ */
+void CoverAtlas::setMaxPages(int maxPages, int screenPages) {
+    this->maxPages = std::max(1, maxPages);
+    this->screenPages = std::max(this->maxPages, screenPages);
+    stats.budgetBytes = static_cast<size_t>(this->maxPages) * pageBytes();
+    if (static_cast<int>(pages.size()) > this->screenPages) {
+        clear();
+    }
+}
+
+/**
+ * @brief Destroys all pages and forgets every slot.
+ */
+void CoverAtlas::clear() {
+    for (auto& page : pages) {
+        if (page.texture) SDL_DestroyTexture(page.texture);
+        if (page.surface) SDL_FreeSurface(page.surface);
+    }
+    pages.clear();
+    slots.clear();
+    freeSlots.clear();
+    lru.clear();
+    index.clear();
+    missed.clear();
+    stats.entries = 0;
+    stats.residentBytes = 0;
+}
+
+/**
+ * @brief Returns hit/miss/eviction counters and resident page bytes.
+ */
+TextureCacheStats CoverAtlas::getStats() const {
+    return stats;
+}
+
+/**
+ * @brief Returns the size in bytes of a single ARGB8888 page.
+ */
+size_t CoverAtlas::pageBytes() const {
+    return static_cast<size_t>(pageSize) * static_cast<size_t>(pageSize) * 4;
+}
+
+/**
+ * @brief Finds a slot for a new cover: a free one, a new page, or the LRU victim.
+ * @return The slot index, or -1 if every slot is in use this frame.
+ */
+int CoverAtlas::allocateSlot() {
+    if (freeSlots.empty() && static_cast<int>(pages.size()) < maxPages) {
+        addPage();
+    }
+
+    if (!freeSlots.empty()) {
+        int slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+        return slotIndex;
+    }
+
+    if (lru.empty() || slots[lru.back()].lastUsedFrame == frame) {
+        // Everything left is on screen right now: grow past the budget if one screen needs it
+        if (static_cast<int>(pages.size()) < screenPages && addPage() && !freeSlots.empty()) {
+            int slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+            return slotIndex;
+        }
+        return -1;
+    }
+
+    int victim = lru.back();
+
+    index.erase(slots[victim].key);
+    lru.pop_back();
+    slots[victim].key.clear();
+    stats.evictions++;
+    return victim;
+}
+
+/**
+ * @brief Creates a new page texture and adds its cells to the free list.
+ * @return true if the page was created.
+ */
+bool CoverAtlas::addPage() {
+    SDL_Texture* texture = nullptr;
+    SDL_Surface* surface = nullptr;
+    if (compositor) {
+        surface = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageSize, 32, SDL_PIXELFORMAT_ARGB8888);
+    } else {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                    pageSize, pageSize);
+    }
+    if (!texture && !surface) {
+        std::cerr << "Failed to create atlas page! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+
+    int pageIndex = static_cast<int>(pages.size());
+    pages.push_back({texture, surface, {}, {}, {}});
+
+    int cells = cellsPerRow * cellsPerRow;
+    for (int cell = cells - 1; cell >= 0; --cell) {
+        freeSlots.push_back(static_cast<int>(slots.size()) + cell);
+    }
+    for (int cell = 0; cell < cells; ++cell) {
+        slots.push_back({std::string(), pageIndex, cell, 0, false, false, lru.end()});
+    }
+
+    stats.residentBytes = pages.size() * pageBytes();
+    return true;
+}
+
+/**
+ * @brief Returns a slot that failed to upload to the free list.
+ * @param slotIndex The slot to release.
+ */
+void CoverAtlas::releaseSlot(int slotIndex) {
+    Slot& slot = slots[slotIndex];
+    if (!slot.key.empty()) {
+        index.erase(slot.key);
+        if (!slot.pinned) {
+            lru.erase(slot.lruPos);
+        }
+        slot.key.clear();
+    }
+    slot.pinned = false;
+    slot.lruPos = lru.end();
+    freeSlots.push_back(slotIndex);
+    stats.entries = index.size();
+}
+
+/**
+ * @brief Returns the pixel rectangle of a cell within its page.
+ */
+SDL_Rect CoverAtlas::cellRect(int cell) const {
+    return {(cell % cellsPerRow) * cellSize, (cell / cellsPerRow) * cellSize, cellSize, cellSize};
+}
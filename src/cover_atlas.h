@@ -0,0 +1,187 @@
+/**
+ * @file cover_atlas.h
+ * @brief Declares the CoverAtlas class, which packs cover thumbnails into shared texture pages.
+ *
+ * Covers are scaled to a fixed cell size and copied into large atlas pages.
+ * All covers drawn in a frame are queued and submitted with one
+ * SDL_RenderGeometry call per page, instead of one texture bind and draw
+ * call per cover. With a SoftwareCompositor, pages are plain surfaces and
+ * covers are blitted straight into the framebuffer, since the software
+ * renderer rasterizes geometry one triangle pixel at a time.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "render_stats.h"
+#include "software_compositor.h"
+#include "texture_cache.h"
+
+/**
+ * @class CoverAtlas
+ * @brief Fixed-cell texture atlas with LRU slot eviction and batched drawing.
+ */
+class CoverAtlas {
+public:
+    /**
+     * @brief Constructs an empty atlas. Pages are created on demand.
+     * @param cellSize Edge length of each square cover cell in pixels.
+     * @param pageSize Edge length of each atlas page in pixels.
+     * @param maxPages Maximum number of pages to allocate.
+     */
+    CoverAtlas(int cellSize, int pageSize, int maxPages);
+    ~CoverAtlas();
+
+    CoverAtlas(const CoverAtlas&) = delete;
+    CoverAtlas& operator=(const CoverAtlas&) = delete;
+
+    /**
+     * @brief Sets the renderer used to create pages. Must be called before insert().
+     * @param renderer The renderer covers are drawn with.
+     * @param compositor If set, pages are kept as surfaces and drawn by the compositor.
+     */
+    void setRenderer(SDL_Renderer* renderer, SoftwareCompositor* compositor = nullptr);
+
+    /**
+     * @brief Checks whether a cover is resident and marks it as used this frame.
+     *
+     * Counters are kept per key rather than per frame: a cover that is not
+     * resident counts as one miss until it is inserted, and a resident one
+     * counts as a hit when it comes back into use after a frame without it,
+     * however many frames draw it meanwhile.
+     *
+     * @param key The cover key.
+     * @param counted False for fallback draws that must not count as lookups.
+     * @return true if the cover can be drawn with queueDraw().
+     */
+    bool touch(const std::string& key, bool counted = true);
+
+    /**
+     * @brief Returns true if an insert right after this frame could find a slot.
+     *
+     * False while every slot holds a cover drawn in the previous frame and
+     * the atlas cannot grow.
+     */
+    bool hasRoom() const;
+
+    /**
+     * @brief Checks whether a cover is resident without touching it or the counters.
+     */
+    bool contains(const std::string& key) const { return index.count(key) != 0; }
+
+    /**
+     * @brief Copies a cover into a free or evicted slot.
+     *
+     * The surface must be ARGB8888 and exactly cellSize x cellSize. Slots
+     * used in the current frame are never evicted; if every slot is busy
+     * the insert fails and the caller keeps showing its placeholder.
+     *
+     * @param key The cover key.
+     * @param surface Pixels to upload. Ownership stays with the caller.
+     * @param pinned If true the slot is never evicted.
+     * @return true if the cover is now resident.
+     */
+    bool insert(const std::string& key, SDL_Surface* surface, bool pinned = false);
+
+    /**
+     * @brief Queues a resident cover to be drawn in the next flush().
+     * @param key The cover key.
+     * @param dst Destination rectangle on screen.
+     * @return false if the cover is not resident.
+     */
+    bool queueDraw(const std::string& key, const SDL_Rect& dst);
+
+    /**
+     * @brief Submits every queued quad, one geometry call per page.
+     * @param renderer The renderer to draw with.
+     * @param stats Draw counters to update.
+     */
+    void flush(SDL_Renderer* renderer, RenderStats& stats);
+
+    /**
+     * @brief Starts a new frame. Slots touched in the previous frame become evictable.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Changes the page limits. Pages beyond them are released.
+     * @param maxPages Pages the atlas keeps for reuse, its share of the budget.
+     * @param screenPages Pages it may grow to past maxPages when every slot holds a cover on screen.
+     */
+    void setMaxPages(int maxPages, int screenPages = 0);
+
+    /**
+     * @brief Destroys all pages and forgets every slot.
+     */
+    void clear();
+
+    /**
+     * @brief Returns hit/miss/eviction counters and resident page bytes.
+     *
+     * Hits and misses count covers coming into use, not frames; see touch().
+     */
+    TextureCacheStats getStats() const;
+
+    /**
+     * @brief Returns the cell edge length in pixels.
+     */
+    int getCellSize() const { return cellSize; }
+
+    /**
+     * @brief Returns the size in bytes of a single page.
+     */
+    size_t pageBytes() const;
+
+private:
+    struct Slot {
+        std::string key;       ///< Empty when the slot is free.
+        int page;
+        int cell;
+        unsigned int lastUsedFrame;
+        bool pinned;
+        bool opaque;           ///< Every pixel has full alpha, so software blits need not blend.
+        std::list<int>::iterator lruPos;
+    };
+
+    struct Blit {
+        SDL_Rect src;
+        SDL_Rect dst;
+        bool opaque;
+    };
+
+    struct Page {
+        SDL_Texture* texture;
+        SDL_Surface* surface;              ///< Pixels of a software page; texture is null then.
+        std::vector<SDL_Vertex> vertices;  ///< Quads queued for this frame.
+        std::vector<int> indices;
+        std::vector<Blit> blits;           ///< Software draws queued for this frame.
+    };
+
+    SDL_Renderer* renderer;
+    SoftwareCompositor* compositor;
+    int cellSize;
+    int pageSize;
+    int cellsPerRow;
+    int maxPages;
+    int screenPages;  ///< Growth limit for covers that are all on screen.
+    unsigned int frame;
+
+    std::vector<Page> pages;
+    std::vector<Slot> slots;  ///< One entry per cell of every allocated page.
+    std::vector<int> freeSlots;
+    std::list<int> lru;       ///< Occupied, unpinned slots; most recent at the front.
+    std::unordered_map<std::string, int> index;
+    std::unordered_set<std::string> missed;  ///< Keys counted as a miss and not resident since.
+    TextureCacheStats stats;
+
+    void flushSoftware(SDL_Renderer* renderer, RenderStats& stats);
+    int allocateSlot();
+    bool addPage();
+    void releaseSlot(int slotIndex);
+    SDL_Rect cellRect(int cell) const;
+};
@@ -0,0 +1,254 @@
+/**
+ * @file cover_preview.cpp
+ * @brief Implements BlurHash encoding and decoding for cover previews.
+ */
+
+#include "cover_preview.h"
+#include "image_loader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const char BASE83[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@[]^_{|}~";
+const float PI = 3.14159265358979f;
+
+void encode83(int value, int length, std::string& out) {
+    for (int i = 1; i <= length; ++i) {
+        int divisor = 1;
+        for (int k = 0; k < length - i; ++k) divisor *= 83;
+        out += BASE83[(value / divisor) % 83];
+    }
+}
+
+/**
+ * @brief Decodes base 83 digits, returning -1 on a character outside the alphabet.
+ */
+int decode83(const std::string& text, size_t offset, size_t length) {
+    int value = 0;
+    for (size_t i = offset; i < offset + length; ++i) {
+        const char* digit = text[i] == '\0' ? nullptr : std::strchr(BASE83, text[i]);
+        if (!digit) return -1;
+        value = value * 83 + static_cast<int>(digit - BASE83);
+    }
+    return value;
+}
+
+float srgbToLinear(int value) {
+    float v = value / 255.0f;
+    return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+}
+
+int linearToSrgb(float value) {
+    float v = std::clamp(value, 0.0f, 1.0f);
+    float srgb = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+    return static_cast<int>(srgb * 255.0f + 0.5f);
+}
+
+/**
+ * @brief linearToSrgb() through a table, for decoding where it runs for every pixel.
+ */
+Uint32 linearToSrgbFast(float value) {
+    static const int STEPS = 4096;
+    static const std::vector<uint8_t> table = []() {
+        std::vector<uint8_t> values(STEPS + 1);
+        for (int i = 0; i <= STEPS; ++i) values[i] = static_cast<uint8_t>(linearToSrgb(static_cast<float>(i) / STEPS));
+        return values;
+    }();
+    return table[static_cast<int>(std::clamp(value, 0.0f, 1.0f) * STEPS + 0.5f)];
+}
+
+float signPow(float value, float exponent) {
+    return std::copysign(std::pow(std::fabs(value), exponent), value);
+}
+
+} // namespace
+
+/**
+ * @brief Computes the preview of a cover image file.
+ */
+bool CoverPreview::compute(const std::string& path, std::string& hash, uint32_t& dominantColor) {
+    SDL_Surface* sample = ImageLoader::decode(path, SAMPLE_SIZE);
+    if (!sample) {
+        return false;
+    }
+    compute(sample, hash, dominantColor);
+    SDL_FreeSurface(sample);
+    return true;
+}
+
+/**
+ * @brief Computes the preview of an ARGB8888 surface.
+ *
+ * The hash is a standard BlurHash over linear light. The dominant color
+ * is the average of the most populated bin of a 4-bit-per-channel
+ * histogram, ignoring mostly transparent pixels.
+ */
+void CoverPreview::compute(const SDL_Surface* surface, std::string& hash, uint32_t& dominantColor) {
+    const int width = surface->w;
+    const int height = surface->h;
+    const int count = COMPONENTS_X * COMPONENTS_Y;
+
+    std::vector<float> cosX(static_cast<size_t>(COMPONENTS_X) * width);
+    std::vector<float> cosY(static_cast<size_t>(COMPONENTS_Y) * height);
+    for (int i = 0; i < COMPONENTS_X; ++i) {
+        for (int x = 0; x < width; ++x) cosX[i * width + x] = std::cos(PI * i * x / width);
+    }
+    for (int j = 0; j < COMPONENTS_Y; ++j) {
+        for (int y = 0; y < height; ++y) cosY[j * height + y] = std::cos(PI * j * y / height);
+    }
+
+    float factors[COMPONENTS_X * COMPONENTS_Y][3] = {};
+    std::vector<uint32_t> binCounts(4096, 0);
+    std::vector<uint32_t> binSums(4096 * 3, 0);
+    float linear[256];
+    for (int v = 0; v < 256; ++v) linear[v] = srgbToLinear(v);
+
+    for (int y = 0; y < height; ++y) {
+        const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(surface->pixels) + y * surface->pitch);
+        for (int x = 0; x < width; ++x) {
+            const Uint32 p = row[x];
+            const int r = (p >> 16) & 0xFF, g = (p >> 8) & 0xFF, b = p & 0xFF;
+            for (int j = 0; j < COMPONENTS_Y; ++j) {
+                for (int i = 0; i < COMPONENTS_X; ++i) {
+                    float basis = cosX[i * width + x] * cosY[j * height + y];
+                    float* factor = factors[j * COMPONENTS_X + i];
+                    factor[0] += basis * linear[r];
+                    factor[1] += basis * linear[g];
+                    factor[2] += basis * linear[b];
+                }
+            }
+
+            if ((p >> 24) >= 128) {
+                int bin = ((r >> 4) << 8) | ((g >> 4) << 4) | (b >> 4);
+                binCounts[bin]++;
+                binSums[bin * 3] += r;
+                binSums[bin * 3 + 1] += g;
+                binSums[bin * 3 + 2] += b;
+            }
+        }
+    }
+
+    for (int k = 0; k < count; ++k) {
+        float scale = (k == 0 ? 1.0f : 2.0f) / (width * height);
+        for (float& channel : factors[k]) channel *= scale;
+    }
+
+    hash.clear();
+    encode83((COMPONENTS_X - 1) + (COMPONENTS_Y - 1) * 9, 1, hash);
+
+    float actualMax = 0.0f;
+    for (int k = 1; k < count; ++k) {
+        for (float channel : factors[k]) actualMax = std::max(actualMax, std::fabs(channel));
+    }
+    int quantisedMax = std::clamp(static_cast<int>(std::floor(actualMax * 166.0f - 0.5f)), 0, 82);
+    const float maxValue = (quantisedMax + 1) / 166.0f;
+    encode83(quantisedMax, 1, hash);
+
+    const int dc = (linearToSrgb(factors[0][0]) << 16) | (linearToSrgb(factors[0][1]) << 8) | linearToSrgb(factors[0][2]);
+    encode83(dc, 4, hash);
+
+    for (int k = 1; k < count; ++k) {
+        int quantised[3];
+        for (int c = 0; c < 3; ++c) {
+            quantised[c] = std::clamp(static_cast<int>(std::floor(signPow(factors[k][c] / maxValue, 0.5f) * 9.0f + 9.5f)), 0, 18);
+        }
+        encode83(quantised[0] * 19 * 19 + quantised[1] * 19 + quantised[2], 2, hash);
+    }
+
+    int best = static_cast<int>(std::max_element(binCounts.begin(), binCounts.end()) - binCounts.begin());
+    if (binCounts[best] == 0) {
+        dominantColor = 0xFF000000u | static_cast<uint32_t>(dc);  // Fully transparent: use the average
+    } else {
+        const uint32_t n = binCounts[best];
+        dominantColor = 0xFF000000u | ((binSums[best * 3] / n) << 16) | ((binSums[best * 3 + 1] / n) << 8) |
+                        (binSums[best * 3 + 2] / n);
+    }
+}
+
+/**
+ * @brief Returns true if hash is a well-formed BlurHash code.
+ */
+bool CoverPreview::isValid(const std::string& hash) {
+    if (hash.size() < 6) {
+        return false;
+    }
+    int sizeFlag = decode83(hash, 0, 1);
+    if (sizeFlag < 0) {
+        return false;
+    }
+    size_t components = static_cast<size_t>(sizeFlag % 9 + 1) * (sizeFlag / 9 + 1);
+    if (hash.size() != 4 + 2 * components) {
+        return false;
+    }
+    for (size_t i = 1; i < hash.size(); ++i) {
+        if (decode83(hash, i, 1) < 0) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Renders a preview into a new square ARGB8888 surface.
+ */
+SDL_Surface* CoverPreview::decode(const std::string& hash, int size) {
+    if (!isValid(hash) || size <= 0) {
+        return nullptr;
+    }
+
+    const int sizeFlag = decode83(hash, 0, 1);
+    const int numX = sizeFlag % 9 + 1;
+    const int numY = sizeFlag / 9 + 1;
+    const float maxValue = (decode83(hash, 1, 1) + 1) / 166.0f;
+
+    std::vector<float> colors(static_cast<size_t>(numX) * numY * 3);
+    const int dc = decode83(hash, 2, 4);
+    if (dc > 0xFFFFFF) {
+        return nullptr;
+    }
+    colors[0] = srgbToLinear(dc >> 16);
+    colors[1] = srgbToLinear((dc >> 8) & 0xFF);
+    colors[2] = srgbToLinear(dc & 0xFF);
+    for (int k = 1; k < numX * numY; ++k) {
+        const int value = decode83(hash, 4 + k * 2, 2);
+        const int quantised[3] = {value / (19 * 19), (value / 19) % 19, value % 19};
+        for (int c = 0; c < 3; ++c) {
+            colors[k * 3 + c] = signPow((quantised[c] - 9) / 9.0f, 2.0f) * maxValue;
+        }
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return nullptr;
+    }
+
+    std::vector<float> cosines(static_cast<size_t>(std::max(numX, numY)) * size);
+    for (int i = 0; i < std::max(numX, numY); ++i) {
+        for (int p = 0; p < size; ++p) cosines[i * size + p] = std::cos(PI * i * p / size);
+    }
+
+    std::vector<float> rowColors(static_cast<size_t>(numX) * 3);
+    for (int y = 0; y < size; ++y) {
+        // Fold the vertical basis into the components once per row
+        std::fill(rowColors.begin(), rowColors.end(), 0.0f);
+        for (int j = 0; j < numY; ++j) {
+            const float basisY = cosines[j * size + y];
+            for (int i = 0; i < numX; ++i) {
+                for (int c = 0; c < 3; ++c) rowColors[i * 3 + c] += basisY * colors[(j * numX + i) * 3 + c];
+            }
+        }
+
+        Uint32* out = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+        for (int x = 0; x < size; ++x) {
+            float rgb[3] = {0.0f, 0.0f, 0.0f};
+            for (int i = 0; i < numX; ++i) {
+                const float basisX = cosines[i * size + x];
+                for (int c = 0; c < 3; ++c) rgb[c] += basisX * rowColors[i * 3 + c];
+            }
+            out[x] = 0xFF000000u | (linearToSrgbFast(rgb[0]) << 16) | (linearToSrgbFast(rgb[1]) << 8) |
+                     linearToSrgbFast(rgb[2]);
+        }
+    }
+    return surface;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file cover_preview.h
+ * @brief Declares CoverPreview, a tiny blurred stand-in for a cover and its dominant color.
+ *
+ * A cover takes a file read, a decode and an upload before it can be
+ * drawn. Its preview is computed once when the cover is downloaded and
+ * kept with the game's metadata: a BlurHash code of 28 characters (the
+ * average color plus a 4x3 grid of cosine components) and the most common
+ * color. Rows can then be painted with a believable blur straight from
+ * memory on the very first frame, and the real cover replaces it once it
+ * streams in.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class CoverPreview
+ * @brief Encodes and decodes BlurHash previews of cover art.
+ */
+class CoverPreview {
+public:
+    static const int COMPONENTS_X = 4;
+    static const int COMPONENTS_Y = 3;
+
+    /**
+     * @brief Computes the preview of a cover image file.
+     * @param path The cover file.
+     * @param hash Receives the BlurHash code.
+     * @param dominantColor Receives the most common color as opaque 0xAARRGGBB.
+     * @return false if the file could not be decoded; the outputs are then unchanged.
+     */
+    static bool compute(const std::string& path, std::string& hash, uint32_t& dominantColor);
+
+    /**
+     * @brief Computes the preview of an ARGB8888 surface.
+     */
+    static void compute(const SDL_Surface* surface, std::string& hash, uint32_t& dominantColor);
+
+    /**
+     * @brief Returns true if hash is a well-formed BlurHash code.
+     */
+    static bool isValid(const std::string& hash);
+
+    /**
+     * @brief Renders a preview into a new square ARGB8888 surface.
+     * @param hash A BlurHash code.
+     * @param size Edge length of the result.
+     * @return The surface (owned by the caller), or nullptr if hash is invalid.
+     */
+    static SDL_Surface* decode(const std::string& hash, int size);
+
+private:
+    /// Covers are reduced to this many pixels a side before encoding; the hash cannot hold more detail
+    static const int SAMPLE_SIZE = 32;
+};
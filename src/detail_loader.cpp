@@ -0,0 +1,200 @@
+/**
+ * @file detail_loader.cpp
+ * @brief Implements the DetailLoader background fetcher and its on-disk cache.
+ */
+
+#include "detail_loader.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Constructs an idle loader. Call start() to spawn the worker.
+ */
+DetailLoader::DetailLoader() : version(0), client(nullptr), stopping(false) {}
+
+/**
+ * @brief Stops the worker.
+ */
+DetailLoader::~DetailLoader() {
+    stop();
+}
+
+/**
+ * @brief Starts the worker.
+ * @param client Client used for cache misses, or nullptr to serve only cached details.
+ * @param cacheDir Directory holding one JSON file per game.
+ */
+void DetailLoader::start(IGDBClient* client, const std::string& cacheDir) {
+    if (worker.joinable()) return;
+
+    this->client = client;
+    this->cacheDir = cacheDir;
+    stopping = false;
+    worker = std::thread(&DetailLoader::workerLoop, this);
+}
+
+/**
+ * @brief Stops the worker and forgets every result.
+ */
+void DetailLoader::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    wake.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+/**
+ * @brief Queues the details of a game unless they are loaded or on their way.
+ * @param igdbUrl The game's IGDB page.
+ * @return true if the request was newly queued.
+ */
+bool DetailLoader::request(const std::string& igdbUrl) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || !worker.joinable() || igdbUrl.empty()) {
+            return false;
+        }
+
+        Entry& entry = entries[igdbUrl];
+        if (entry.state == State::Loading || entry.state == State::Ready) {
+            return false;
+        }
+        entry.state = State::Loading;
+        queue.push_front(igdbUrl);
+    }
+    wake.notify_one();
+    return true;
+}
+
+/**
+ * @brief Returns how far the details of a game have got.
+ */
+DetailLoader::State DetailLoader::getState(const std::string& igdbUrl) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(igdbUrl);
+    return it == entries.end() ? State::Missing : it->second.state;
+}
+
+/**
+ * @brief Returns the details of a game once they are Ready.
+ *
+ * Entries are never erased or rewritten once Ready, so the pointer stays
+ * valid without holding the lock.
+ */
+const GameDetails* DetailLoader::find(const std::string& igdbUrl) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(igdbUrl);
+    return it != entries.end() && it->second.state == State::Ready ? &it->second.details : nullptr;
+}
+
+/**
+ * @brief Serves requests newest first: from the disk cache if present, else from IGDB.
+ */
+void DetailLoader::workerLoop() {
+    while (true) {
+        std::string url;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            url = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        GameDetails details;
+        const std::string path = cachePath(url);
+        bool ok = !path.empty() && loadCached(path, details);
+        if (!ok && client) {
+            ok = client->fetchGameDetails(url, details);
+            if (ok) {
+                saveCached(path, details);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Entry& entry = entries[url];
+            if (ok) {
+                entry.details = std::move(details);
+            }
+            entry.state = ok ? State::Ready : State::Failed;
+        }
+        version++;
+    }
+}
+
+/**
+ * @brief Returns the cache file of a game, named after its IGDB slug.
+ * @return The path, or an empty string if the URL has no usable slug.
+ */
+std::string DetailLoader::cachePath(const std::string& igdbUrl) const {
+    std::string slug = IGDBClient::slugFromUrl(igdbUrl);
+    return slug.empty() ? std::string() : cacheDir + "/" + slug + ".json";
+}
+
+/**
+ * @brief Reads cached details written by saveCached().
+ * @return false if the file is missing or unreadable.
+ */
+bool DetailLoader::loadCached(const std::string& path, GameDetails& details) const {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    try {
+        nlohmann::json json = nlohmann::json::parse(in);
+        details.storyline = json.value("storyline", "");
+        details.rating = json.value("rating", -1);
+        details.ratingCount = json.value("rating_count", 0);
+        details.screenshots = json.value("screenshots", std::vector<std::string>());
+        details.artworks = json.value("artworks", std::vector<std::string>());
+        details.similarGames = json.value("similar_games", std::vector<std::string>());
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Ignoring unreadable details cache " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Writes fetched details to the cache directory.
+ */
+void DetailLoader::saveCached(const std::string& path, const GameDetails& details) const {
+    if (path.empty()) return;
+
+    nlohmann::json json = {
+        {"storyline", details.storyline},
+        {"rating", details.rating},
+        {"rating_count", details.ratingCount},
+        {"screenshots", details.screenshots},
+        {"artworks", details.artworks},
+        {"similar_games", details.similarGames},
+    };
+
+    try {
+        fs::create_directories(cacheDir);
+        std::ofstream out(path);
+        out << json.dump(2);
+        if (!out) {
+            std::cerr << "Failed to write details cache " << path << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to write details cache " << path << ": " << e.what() << std::endl;
+    }
+}
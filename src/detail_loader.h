@@ -0,0 +1,104 @@
+/**
+ * @file detail_loader.h
+ * @brief Declares DetailLoader, which fetches extended game details in the background.
+ *
+ * Details are wanted one game at a time, when the user opens a detail
+ * pane, so a single worker fetches them. Each result is kept in memory
+ * for the session and written to its own JSON file, so a pane opened
+ * again later, even after a restart, needs no network round trip.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "game_details.h"
+#include "igdb_client.h"
+
+/**
+ * @class DetailLoader
+ * @brief Fetches and caches GameDetails by IGDB URL on a worker thread.
+ */
+class DetailLoader {
+public:
+    /// Where the details of one game are
+    enum class State {
+        Missing,  ///< Never requested.
+        Loading,  ///< Queued or being fetched.
+        Ready,    ///< Available from find().
+        Failed    ///< Not cached and IGDB did not return them; request() tries again.
+    };
+
+    DetailLoader();
+    ~DetailLoader();
+
+    DetailLoader(const DetailLoader&) = delete;
+    DetailLoader& operator=(const DetailLoader&) = delete;
+
+    /**
+     * @brief Starts the worker.
+     * @param client Client used for cache misses, or nullptr to serve only cached details.
+     *               It must outlive the worker.
+     * @param cacheDir Directory holding one JSON file per game.
+     */
+    void start(IGDBClient* client, const std::string& cacheDir = "details");
+
+    /**
+     * @brief Stops the worker. Requests still queued are dropped.
+     */
+    void stop();
+
+    bool isRunning() const { return worker.joinable(); }
+
+    /**
+     * @brief Queues the details of a game unless they are loaded or on their way.
+     *
+     * Newer requests are served first: the pane open now is the one that matters.
+     *
+     * @param igdbUrl The game's IGDB page.
+     * @return true if the request was newly queued.
+     */
+    bool request(const std::string& igdbUrl);
+
+    /**
+     * @brief Returns how far the details of a game have got.
+     */
+    State getState(const std::string& igdbUrl) const;
+
+    /**
+     * @brief Returns the details of a game once they are Ready.
+     * @return The details, valid until stop(), or nullptr if not Ready.
+     */
+    const GameDetails* find(const std::string& igdbUrl) const;
+
+    /**
+     * @brief Returns a counter bumped every time a request finishes, to detect new results.
+     */
+    unsigned int getVersion() const { return version.load(); }
+
+private:
+    struct Entry {
+        State state = State::Missing;
+        GameDetails details;  ///< Written once, before state becomes Ready.
+    };
+
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::string> queue;  ///< URLs waiting for the worker, newest first.
+    std::unordered_map<std::string, Entry> entries;
+    std::atomic<unsigned int> version;
+    IGDBClient* client;
+    std::string cacheDir;
+    bool stopping;
+
+    void workerLoop();
+    std::string cachePath(const std::string& igdbUrl) const;
+    bool loadCached(const std::string& path, GameDetails& details) const;
+    void saveCached(const std::string& path, const GameDetails& details) const;
+};
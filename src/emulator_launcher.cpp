@@ -10,8 +10,94 @@
  */
 
 #include "emulator_launcher.h"
+#include <algorithm>
 #include <stdexcept>
 #include <cstdlib>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+
+/**
+ * @brief Finds the executable posix_spawnp() would run for a program name.
+ * @return Its path, or an empty string if there is none.
+ */
+std::string resolveExecutable(const std::string& program) {
+    if (program.find('/') != std::string::npos) {
+        return access(program.c_str(), X_OK) == 0 ? program : std::string();
+    }
+
+    const char* path = std::getenv("PATH");
+    std::string dirs = path ? path : "/usr/local/bin:/usr/bin:/bin";
+    size_t begin = 0;
+    while (begin <= dirs.size()) {
+        size_t end = dirs.find(':', begin);
+        if (end == std::string::npos) end = dirs.size();
+        std::string dir = dirs.substr(begin, end - begin);
+        std::string candidate = (dir.empty() ? std::string(".") : dir) + "/" + program;
+        std::error_code error;
+        if (access(candidate.c_str(), X_OK) == 0 && std::filesystem::is_regular_file(candidate, error)) {
+            return candidate;
+        }
+        begin = end + 1;
+    }
+    return std::string();
+}
+
+/**
+ * @brief Asks a child to exit, kills it if it has not within graceMillis, and reaps it.
+ *
+ * The wait is bounded so an emulator that ignores SIGTERM cannot freeze
+ * the caller. A pidfd wakes the wait the moment the child exits; kernels
+ * without pidfds fall back to checking every pollMillis.
+ *
+ * @return Its waitpid() status, or -1 if it could not be reaped.
+ */
+int terminateAndReap(pid_t pid, int graceMillis, int pollMillis) {
+    kill(pid, SIGTERM);
+    int status = 0;
+    bool exited = false;
+#ifdef SYS_pidfd_open
+    int pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd >= 0) {
+        pollfd fd = {pidfd, POLLIN, 0};
+        exited = poll(&fd, 1, graceMillis) > 0;
+        close(pidfd);
+    } else
+#endif
+    {
+        for (int waited = 0; waited < graceMillis; waited += pollMillis) {
+            pid_t result = waitpid(pid, &status, WNOHANG);
+            if (result == pid) return status;
+            if (result < 0) return -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(pollMillis));
+        }
+    }
+    if (!exited) {
+        kill(pid, SIGKILL);
+    }
+    pid_t result;
+    do {
+        result = waitpid(pid, &status, 0);
+    } while (result < 0 && errno == EINTR);
+    return result == pid ? status : -1;
+}
+
+} // namespace
+#endif
 
 /**
  * @class EmulatorLauncher
@@ -27,14 +113,47 @@
  * The emulator is not initialized until the init() method is called with
  * a valid emulator path.
  */
-EmulatorLauncher::EmulatorLauncher() : initialized(false) {}
+EmulatorLauncher::EmulatorLauncher()
+    : initialized(false), lastLaunchMillis(0.0), lastFirstFrameMillis(-1.0), lastLaunchWarm(false),
+      lastLaunchPrepared(false) {
+#ifndef _WIN32
+    childPid = -1;
+    childExited = false;
+    childExitStatus = 0;
+    controlProtocol = false;
+    poolSize = 0;
+    prepareGeneration = 0;
+    prepareStopping = false;
+#endif
+}
 
 /**
  * @brief Destructor for EmulatorLauncher.
  *
- * Cleans up resources if necessary. Currently, no special cleanup is required.
+ * A game still running is left alone; one that has exited is reaped.
+ * Warm processes are terminated and the preparer thread is stopped.
  */
-EmulatorLauncher::~EmulatorLauncher() {}
+EmulatorLauncher::~EmulatorLauncher() {
+    isRunning();
+#ifndef _WIN32
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex);
+        prepareStopping = true;
+    }
+    prepareWake.notify_one();
+    if (preparer.joinable()) {
+        preparer.join();
+    }
+    // Ask them all first so their grace periods overlap
+    for (const WarmProcess& process : pool) {
+        kill(process.pid, SIGTERM);
+    }
+    for (const WarmProcess& process : pool) {
+        discardWarm(process);
+    }
+    pool.clear();
+#endif
+}
 
 /**
  * @brief Initializes the emulator with the specified path.
@@ -49,7 +168,14 @@ bool EmulatorLauncher::init(const std::string& path) {
         setError("No emulator path specified");
         return false;
     }
-    
+
+#ifndef _WIN32
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex);
+        resolvedEmulator.clear();
+        preparedRom.clear();
+    }
+#endif
     initialized = true;
     return true;
 }
@@ -66,26 +192,458 @@ bool EmulatorLauncher::launchGame(const std::filesystem::path& romPath) {
         return false;
     }
     
-    if (!validateRom(romPath)) {
+#ifdef _WIN32
+    lastLaunchPrepared = false;
+#else
+    childExited = false;
+    lastLaunchPrepared = consumePreparation(romPath);
+#endif
+    if (!lastLaunchPrepared && !validateRom(romPath)) {
         return false;
     }
     
-    std::string command;
+    auto start = std::chrono::steady_clock::now();
+    lastLaunchTime = std::chrono::system_clock::now();
+    lastFirstFrameMillis = -1.0;
+    lastLaunchWarm = false;
     #ifdef _WIN32
-        command = "start \"\" \"" + emulatorPath + "\" \"" + romPath.string() + "\"";
+        std::string command = "start \"\" \"" + emulatorPath + "\" \"" + romPath.string() + "\"";
+        int result = std::system(command.c_str());
+        lastLaunchMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (result != 0) {
+            setError("Failed to launch emulator");
+            return false;
+        }
+        return true;
     #else
-        command = "\"" + emulatorPath + "\" \"" + romPath.string() + "\" &";
+        if (isRunning()) {
+            setError("A game is already running");
+            return false;
+        }
+
+        std::string rom = romPath.string();
+        if (!controlProtocol) {
+            bool started = spawnEmulator({rom}, childPid, nullptr);
+            lastLaunchMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return started && watchEarlyExit();
+        }
+
+        if (rom.find('\n') != std::string::npos) {
+            setError("ROM path contains a line break: " + rom);
+            return false;
+        }
+        int control = -1;
+        if (launchWarm(rom, control)) {
+            lastLaunchWarm = true;
+        } else if (!spawnEmulator({"--control-fd=" + std::to_string(CONTROL_FD), rom}, childPid, &control)) {
+            return false;
+        }
+        lastLaunchMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        bool ok = waitForFirstFrame(control, start);
+        close(control);
+        return ok;
     #endif
-    
-    int result = std::system(command.c_str());
+}
+
+/**
+ * @brief Returns true while the last launched emulator is running, reaping it once it has exited.
+ */
+bool EmulatorLauncher::isRunning() {
+#ifdef _WIN32
+    return false;
+#else
+    if (childPid <= 0) {
+        return false;
+    }
+    int status = 0;
+    pid_t result = waitpid(childPid, &status, WNOHANG);
+    if (result == 0) {
+        return true;
+    }
+    if (result == childPid) {
+        recordExit(status);
+    }
+    childPid = -1;
+    return false;
+#endif
+}
+
+#ifndef _WIN32
+/**
+ * @brief Keeps emulator processes started ahead of time, for emulators that speak the control protocol.
+ * @param size Number of warm processes to keep; 0 still uses the protocol for cold launches.
+ */
+void EmulatorLauncher::enableWarmPool(size_t size) {
+    controlProtocol = true;
+    poolSize = size;
+    while (pool.size() > poolSize) {
+        discardWarm(pool.back());
+        pool.pop_back();
+    }
+}
+
+/**
+ * @brief Starts warm processes until the pool is full again.
+ */
+void EmulatorLauncher::refillPool() {
+    // Drop processes that died while waiting, e.g. killed by the user
+    for (auto it = pool.begin(); it != pool.end();) {
+        if (waitpid(it->pid, nullptr, WNOHANG) != 0) {
+            close(it->control);
+            it = pool.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    while (initialized && pool.size() < poolSize) {
+        WarmProcess process;
+        if (!spawnEmulator({"--control-fd=" + std::to_string(CONTROL_FD)}, process.pid, &process.control)) {
+            break;
+        }
+        pool.push_back(process);
+    }
+}
+
+/**
+ * @brief Prepares the launch of a ROM on a background thread, ahead of the user choosing it.
+ * @param romPath Path to the ROM file the user is likely to launch.
+ */
+void EmulatorLauncher::prepare(const std::filesystem::path& romPath) {
+    if (!initialized) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex);
+        if (!preparedRom.empty() && preparedRom == romPath.string()) {
+            return;
+        }
+        ++prepareGeneration;
+        prepareRequest = romPath;
+        preparedRom.clear();
+    }
+    if (!preparer.joinable()) {
+        preparer = std::thread(&EmulatorLauncher::prepareLoop, this);
+    }
+    prepareWake.notify_one();
+}
+
+/**
+ * @brief Drops a pending or finished preparation, e.g. when the selection moves on.
+ */
+void EmulatorLauncher::cancelPreparation() {
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    ++prepareGeneration;
+    prepareRequest.clear();
+    preparedRom.clear();
+}
+
+/**
+ * @brief Takes the preparation of a ROM about to be launched, cancelling any other.
+ * @return true if that ROM had been prepared.
+ */
+bool EmulatorLauncher::consumePreparation(const std::filesystem::path& romPath) {
+    std::lock_guard<std::mutex> lock(prepareMutex);
+    bool prepared = !preparedRom.empty() && preparedRom == romPath.string();
+    ++prepareGeneration;
+    prepareRequest.clear();
+    preparedRom.clear();
+    return prepared;
+}
+
+/**
+ * @brief Prepares requested ROMs until the launcher is destroyed.
+ *
+ * The emulator lookup is done once and kept. A request that is replaced
+ * or cancelled is abandoned between steps, and its result is discarded
+ * if it finishes anyway, so a launch never trusts checks made for another
+ * ROM.
+ */
+void EmulatorLauncher::prepareLoop() {
+    std::unique_lock<std::mutex> lock(prepareMutex);
+    while (true) {
+        prepareWake.wait(lock, [this] { return prepareStopping || !prepareRequest.empty(); });
+        if (prepareStopping) {
+            return;
+        }
+        const std::filesystem::path rom = prepareRequest;
+        const unsigned generation = prepareGeneration;
+        const std::string program = emulatorPath;
+        std::string executable = resolvedEmulator;
+        prepareRequest.clear();
+        lock.unlock();
+
+        if (executable.empty()) {
+            executable = resolveExecutable(program);
+        }
+        std::error_code error;
+        bool ready = !executable.empty() && rom.extension() == ".nes" &&
+                     std::filesystem::is_regular_file(rom, error);
+        if (ready && generation == prepareGeneration) {
+            // The emulator reads the whole ROM at startup; have it in memory by then
+            int fd = open(rom.c_str(), O_RDONLY | O_CLOEXEC);
+            ready = fd >= 0;
+            if (ready) {
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                close(fd);
+            }
+        }
+
+        lock.lock();
+        if (!executable.empty() && program == emulatorPath) {
+            resolvedEmulator = executable;
+        }
+        if (ready && generation == prepareGeneration) {
+            preparedRom = rom.string();
+        }
+    }
+}
+
+/**
+ * @brief Starts the emulator with the given arguments, without a shell.
+ *
+ * The ROM path reaches the emulator as one argument, whatever it contains.
+ *
+ * @param args Arguments after the program name.
+ * @param pid Receives the emulator's PID.
+ * @param control If not null, receives our end of a control socket given to the emulator as CONTROL_FD.
+ * @return false, with the error set, if it could not be started.
+ */
+bool EmulatorLauncher::spawnEmulator(const std::vector<std::string>& args, pid_t& pid, int* control) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(emulatorPath.c_str()));
+    for (const std::string& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    // Both ends are close-on-exec, so no other child inherits them; dup2 clears it on the emulator's copy
+    int sockets[2] = {-1, -1};
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if (control) {
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) != 0) {
+            setError(std::string("Failed to create control socket: ") + std::strerror(errno));
+            posix_spawn_file_actions_destroy(&actions);
+            return false;
+        }
+        if (sockets[1] == CONTROL_FD) {
+            // dup2 onto itself would keep close-on-exec set
+            int moved = fcntl(sockets[1], F_DUPFD_CLOEXEC, CONTROL_FD + 1);
+            close(sockets[1]);
+            sockets[1] = moved;
+        }
+        posix_spawn_file_actions_adddup2(&actions, sockets[1], CONTROL_FD);
+    }
+
+    // A prepared launch already found the executable; otherwise search PATH now
+    std::string executable;
+    {
+        std::lock_guard<std::mutex> lock(prepareMutex);
+        executable = resolvedEmulator;
+    }
+    int result = executable.empty()
+                     ? posix_spawnp(&pid, emulatorPath.c_str(), &actions, nullptr, argv.data(), environ)
+                     : posix_spawn(&pid, executable.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (control) {
+        close(sockets[1]);
+    }
     if (result != 0) {
-        setError("Failed to launch emulator");
+        if (control) close(sockets[0]);
+        pid = -1;
+        setError("Failed to start " + emulatorPath + ": " + std::strerror(result));
         return false;
     }
-    
+    if (control) {
+        *control = sockets[0];
+    }
     return true;
 }
 
+/**
+ * @brief Hands a ROM to a warm process, making it the running emulator.
+ * @param rom Path of the ROM, without line breaks.
+ * @param control Receives our end of the emulator's control socket.
+ * @return false if the pool is empty or no warm process accepted it.
+ */
+bool EmulatorLauncher::launchWarm(const std::string& rom, int& control) {
+    const std::string command = "load " + rom + "\n";
+    while (!pool.empty()) {
+        WarmProcess process = pool.back();
+        pool.pop_back();
+        if (send(process.control, command.data(), command.size(), MSG_NOSIGNAL) ==
+            static_cast<ssize_t>(command.size())) {
+            childPid = process.pid;
+            control = process.control;
+            return true;
+        }
+        discardWarm(process);  // It died while waiting
+    }
+    return false;
+}
+
+/**
+ * @brief Waits for the emulator to report its first frame on its control socket.
+ *
+ * An emulator that stays silent for FIRST_FRAME_TIMEOUT_MS is assumed to
+ * be running; one that closes the socket is watched like any fresh launch.
+ * The wait is sliced so waitCallback keeps the caller's window alive.
+ *
+ * @param control Our end of the emulator's control socket.
+ * @param start When the launch began.
+ * @return false, with the error set, if it reported an error or exited.
+ */
+bool EmulatorLauncher::waitForFirstFrame(int control, std::chrono::steady_clock::time_point start) {
+    const auto deadline = start + std::chrono::milliseconds(FIRST_FRAME_TIMEOUT_MS);
+    std::string line;
+    while (true) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return true;
+        }
+        pollfd fd = {control, POLLIN, 0};
+        int ready = poll(&fd, 1, static_cast<int>(std::min<long long>(remaining.count(), WAIT_SLICE_MS)));
+        if (ready == 0) {
+            if (waitCallback) waitCallback();
+            continue;
+        }
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            return true;
+        }
+
+        char buffer[256];
+        ssize_t count = read(control, buffer, sizeof(buffer));
+        if (count <= 0) {
+            return watchEarlyExit();
+        }
+        line.append(buffer, static_cast<size_t>(count));
+
+        size_t end = line.find('\n');
+        if (end == std::string::npos) continue;
+        line.resize(end);
+        if (line == "frame") {
+            lastFirstFrameMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return true;
+        }
+        if (line.compare(0, 6, "error ") == 0) {
+            setError(line.substr(6));
+            // Usually exiting already; make sure it does not linger
+            int status = terminateAndReap(childPid, TERMINATE_GRACE_MS, EARLY_EXIT_POLL_MS);
+            if (status != -1) {
+                std::string reported = lastError;
+                recordExit(status);
+                setError(reported);  // What the emulator said beats how it ended
+            }
+            childPid = -1;
+            return false;
+        }
+        return true;  // Not part of the protocol; the emulator is up
+    }
+}
+
+/**
+ * @brief Terminates and reaps a warm process, killing it if it ignores SIGTERM.
+ */
+void EmulatorLauncher::discardWarm(const WarmProcess& process) {
+    close(process.control);
+    terminateAndReap(process.pid, TERMINATE_GRACE_MS, EARLY_EXIT_POLL_MS);
+}
+
+/**
+ * @brief Hands the running emulator over to a supervisor, which becomes the one to reap it.
+ *
+ * One that has already exited is reaped here, and its exit waits in takeExit().
+ *
+ * @return The emulator's PID, or -1 if none is running.
+ */
+pid_t EmulatorLauncher::detachChild() {
+    pid_t pid = isRunning() ? childPid : -1;
+    childPid = -1;
+    return pid;
+}
+
+/**
+ * @brief Takes the exit of the last launched emulator, if the launcher reaped it itself.
+ * @param status Receives the waitpid() status.
+ * @param stopped Receives when it was reaped.
+ * @return false if it was not reaped here or was already taken.
+ */
+bool EmulatorLauncher::takeExit(int& status, std::chrono::system_clock::time_point& stopped) {
+    if (!childExited) {
+        return false;
+    }
+    childExited = false;
+    status = childExitStatus;
+    stopped = childExitTime;
+    return true;
+}
+
+/**
+ * @brief Waits up to EARLY_EXIT_WINDOW_MS for the emulator to fail at startup.
+ *
+ * A failed exec is reported by posix_spawnp() itself, but an emulator
+ * that starts and then rejects the ROM or misses a library only shows up
+ * as a quick exit. A pidfd wakes the wait the moment the emulator exits;
+ * kernels without pidfds fall back to checking every EARLY_EXIT_POLL_MS.
+ *
+ * @return false, with the error set, if it exited unsuccessfully.
+ */
+bool EmulatorLauncher::watchEarlyExit() {
+#ifdef SYS_pidfd_open
+    int pidfd = static_cast<int>(syscall(SYS_pidfd_open, childPid, 0));
+    if (pidfd >= 0) {
+        pollfd fd = {pidfd, POLLIN, 0};
+        int ready = poll(&fd, 1, EARLY_EXIT_WINDOW_MS);
+        close(pidfd);
+        if (ready <= 0) {
+            return true;  // Still running (or interrupted, which is no reason to fail)
+        }
+        int status = 0;
+        pid_t result = waitpid(childPid, &status, 0);
+        childPid = -1;
+        return result < 0 || recordExit(status);
+    }
+#endif
+    for (int waited = 0; waited < EARLY_EXIT_WINDOW_MS; waited += EARLY_EXIT_POLL_MS) {
+        int status = 0;
+        pid_t result = waitpid(childPid, &status, WNOHANG);
+        if (result == childPid) {
+            childPid = -1;
+            return recordExit(status);
+        }
+        if (result < 0) {
+            childPid = -1;
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(EARLY_EXIT_POLL_MS));
+    }
+    return true;
+}
+
+/**
+ * @brief Records why the emulator exited, from a waitpid() status, and keeps it for takeExit().
+ * @return true if it exited with status 0.
+ */
+bool EmulatorLauncher::recordExit(int status) {
+    childExited = true;
+    childExitStatus = status;
+    childExitTime = std::chrono::system_clock::now();
+    if (WIFEXITED(status)) {
+        if (WEXITSTATUS(status) == 0) {
+            return true;
+        }
+        // posix_spawnp() reports exec failures as exit status 127 on some C libraries
+        setError(emulatorPath + " exited with status " + std::to_string(WEXITSTATUS(status)));
+    } else if (WIFSIGNALED(status)) {
+        setError(emulatorPath + " was killed by signal " + std::to_string(WTERMSIG(status)));
+    }
+    return false;
+}
+#endif
+
 /**
  * @brief Validates if the ROM file exists and has the correct file extension (.nes).
  *
@@ -9,8 +9,18 @@
  */
 
 #pragma once
+#include <chrono>
+#include <functional>
 #include <string>
 #include <filesystem>
+#include <vector>
+#ifndef _WIN32
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <sys/types.h>
+#endif
 
 /**
  * @class EmulatorLauncher
@@ -39,14 +49,119 @@ public:
      */
     bool init(const std::string& emulatorPath);
 
+    /// Called on the launching thread every WAIT_SLICE_MS while a launch waits for the emulator
+    using WaitCallback = std::function<void()>;
+
+    /**
+     * @brief Sets what a launch does while it waits, e.g. servicing the UI's window.
+     */
+    void setWaitCallback(WaitCallback callback) { waitCallback = std::move(callback); }
+
+#ifndef _WIN32
+    /**
+     * @brief Keeps emulator processes started ahead of time, for emulators that speak the control protocol.
+     *
+     * Such an emulator is passed --control-fd=N. Started without a ROM, it
+     * finishes its startup and waits for "load PATH" on descriptor N; with
+     * or without one, it answers "frame" once its first frame is up, or
+     * "error MESSAGE". tools/stub_emulator.cpp implements the protocol.
+     * Launches then skip the emulator's startup, and the time to the first
+     * frame is measured on both the warm and the cold path.
+     *
+     * @param size Number of warm processes to keep; 0 still uses the protocol for cold launches.
+     */
+    void enableWarmPool(size_t size);
+
+    /**
+     * @brief Starts warm processes until the pool is full again.
+     *
+     * Call when the launcher is idle: a game that was just started should
+     * not compete with new emulators for the CPU.
+     */
+    void refillPool();
+
+    /**
+     * @brief Prepares the launch of a ROM on a background thread, ahead of the user choosing it.
+     *
+     * The emulator executable is looked up on PATH and checked once, and the
+     * ROM is validated and its pages are read into the page cache. If the
+     * same ROM is then launched, launchGame() does no file system I/O of its
+     * own and the emulator finds the ROM in memory. A newer call replaces
+     * the pending one.
+     *
+     * @param romPath Path to the ROM file the user is likely to launch.
+     */
+    void prepare(const std::filesystem::path& romPath);
+
+    /**
+     * @brief Drops a pending or finished preparation, e.g. when the selection moves on.
+     */
+    void cancelPreparation();
+#endif
+
     /**
      * @brief Launches a game ROM using the initialized emulator.
      *
+     * The emulator is started directly from an argument vector, without a
+     * shell, so ROM names may contain any character. Launching fails if the
+     * executable cannot be run or if the emulator exits with an error
+     * within EARLY_EXIT_WINDOW_MS.
+     *
      * @param romPath Path to the ROM file to launch.
      * @return true if the game launches successfully, false otherwise.
      */
     bool launchGame(const std::filesystem::path& romPath);
 
+    /**
+     * @brief Returns true while the last launched emulator is running, reaping it once it has exited.
+     */
+    bool isRunning();
+
+#ifndef _WIN32
+    /**
+     * @brief Hands the running emulator over to a supervisor, which becomes the one to reap it.
+     * @return The emulator's PID, or -1 if none is running.
+     */
+    pid_t detachChild();
+
+    /**
+     * @brief Takes the exit of the last launched emulator, if the launcher reaped it itself.
+     *
+     * An emulator that exits during the launch, or before detachChild(), is
+     * never seen by a supervisor; its session is reported from here instead.
+     *
+     * @param status Receives the waitpid() status.
+     * @param stopped Receives when it was reaped.
+     * @return false if it was not reaped here or was already taken.
+     */
+    bool takeExit(int& status, std::chrono::system_clock::time_point& stopped);
+#endif
+
+    /**
+     * @brief Returns how long the last launch took to start the emulator process, in milliseconds.
+     */
+    double getLastLaunchMillis() const { return lastLaunchMillis; }
+
+    /**
+     * @brief Returns when the last launch started the emulator.
+     */
+    std::chrono::system_clock::time_point getLastLaunchTime() const { return lastLaunchTime; }
+
+    /**
+     * @brief Returns how long the last launch took to the emulator's first frame, or -1 if it did not say.
+     */
+    double getLastFirstFrameMillis() const { return lastFirstFrameMillis; }
+
+    /**
+     * @brief Returns true if the last launch used a warm process from the pool.
+     */
+    bool wasLastLaunchWarm() const { return lastLaunchWarm; }
+
+    /**
+     * @brief Returns true if the last launch had been prepared, skipping its validation and PATH lookup.
+     */
+    bool wasLastLaunchPrepared() const { return lastLaunchPrepared; }
+
     /**
      * @brief Validates if the ROM file exists and has the correct file extension.
      *
@@ -63,9 +178,100 @@ public:
     std::string getLastError() const;
 
 private:
+    /// How long a fresh emulator is watched for an immediate exit (bad ROM, missing libraries)
+    static const int EARLY_EXIT_WINDOW_MS = 200;
+    static const int EARLY_EXIT_POLL_MS = 10;
+    /// How long an emulator told to exit gets before it is killed
+    static const int TERMINATE_GRACE_MS = 300;
+    /// Descriptor the control socket is given in emulators that speak the control protocol
+    static const int CONTROL_FD = 3;
+    /// How long a launch waits for the first frame before assuming the emulator is simply quiet
+    static const int FIRST_FRAME_TIMEOUT_MS = 10000;
+    /// How long a launch waits between calls to waitCallback
+    static const int WAIT_SLICE_MS = 16;
+
     std::string emulatorPath;  ///< Path to the emulator executable.
     std::string lastError;     ///< Stores the last error message.
     bool initialized;          ///< Tracks if the emulator has been initialized.
+    double lastLaunchMillis;   ///< Time spent starting the last emulator process.
+    std::chrono::system_clock::time_point lastLaunchTime;
+    double lastFirstFrameMillis;  ///< Launch to first frame, or -1 if unknown.
+    bool lastLaunchWarm;          ///< The last launch came from the pool.
+    bool lastLaunchPrepared;      ///< The last launch had been prepared.
+    WaitCallback waitCallback;
+#ifndef _WIN32
+    pid_t childPid;            ///< The running emulator, or -1.
+    bool childExited;          ///< The last emulator was reaped here and takeExit() has not taken it.
+    int childExitStatus;       ///< Its waitpid() status.
+    std::chrono::system_clock::time_point childExitTime;
+
+    /// An emulator that has finished starting up and waits for a ROM
+    struct WarmProcess {
+        pid_t pid;
+        int control;  ///< Our end of its control socket.
+    };
+
+    bool controlProtocol;            ///< The emulator accepts --control-fd.
+    size_t poolSize;                 ///< Warm processes to keep.
+    std::vector<WarmProcess> pool;
+
+    // Launch preparation, done on preparer; everything below it is guarded by prepareMutex
+    std::thread preparer;
+    std::mutex prepareMutex;
+    std::condition_variable prepareWake;
+    std::atomic<unsigned> prepareGeneration;  ///< Bumped by every request and cancel, so stale work is dropped.
+    std::filesystem::path prepareRequest;     ///< ROM waiting to be prepared, or empty.
+    std::string preparedRom;                  ///< ROM whose launch needs no more I/O, or empty.
+    std::string resolvedEmulator;             ///< Emulator executable found on PATH, or empty.
+    bool prepareStopping;
+
+    /**
+     * @brief Prepares requested ROMs until the launcher is destroyed.
+     */
+    void prepareLoop();
+
+    /**
+     * @brief Takes the preparation of a ROM about to be launched, cancelling any other.
+     * @return true if that ROM had been prepared.
+     */
+    bool consumePreparation(const std::filesystem::path& romPath);
+
+    /**
+     * @brief Starts the emulator with the given arguments, without a shell.
+     * @param control If not null, receives our end of a control socket given to the emulator.
+     * @return false, with the error set, if it could not be started.
+     */
+    bool spawnEmulator(const std::vector<std::string>& args, pid_t& pid, int* control);
+
+    /**
+     * @brief Hands a ROM to a warm process, making it the running emulator.
+     * @return false if the pool is empty or no warm process accepted it.
+     */
+    bool launchWarm(const std::string& rom, int& control);
+
+    /**
+     * @brief Waits for the emulator to report its first frame on its control socket.
+     * @return false, with the error set, if it reported an error or exited.
+     */
+    bool waitForFirstFrame(int control, std::chrono::steady_clock::time_point start);
+
+    /**
+     * @brief Terminates and reaps a warm process, killing it if it ignores SIGTERM.
+     */
+    void discardWarm(const WarmProcess& process);
+
+    /**
+     * @brief Waits up to EARLY_EXIT_WINDOW_MS for the emulator to fail at startup.
+     * @return false, with the error set, if it exited unsuccessfully.
+     */
+    bool watchEarlyExit();
+
+    /**
+     * @brief Records why the emulator exited, from a waitpid() status, and keeps it for takeExit().
+     * @return true if it exited with status 0.
+     */
+    bool recordExit(int status);
+#endif
 
     /**
      * @brief Sets the error message when an operation fails.
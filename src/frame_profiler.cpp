@@ -0,0 +1,252 @@
+/**
+ * @file frame_profiler.cpp
+ * @brief Implements the FrameProfiler phase timer, rolling histograms and CSV dump.
+ */
+
+#include "frame_profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+/**
+ * @brief Constructs a profiler.
+ * @param historySeconds How many seconds of frames to keep.
+ */
+FrameProfiler::FrameProfiler(double historySeconds)
+    : historySeconds(historySeconds), origin(Clock::now()), head(0), count(0),
+      frameHistogram(HISTOGRAM_BUCKETS, 0), workHistogram(HISTOGRAM_BUCKETS, 0),
+      latencyHistogram(HISTOGRAM_BUCKETS, 0), latencyCount(0), pendingInput(-1.0), current(), inFrame(false), lastFrameStart(-1.0), lastSwitch(0.0), stack(), depth(0) {
+    // Room for the whole window at up to 240 frames per second
+    ring.resize(static_cast<size_t>(historySeconds * 240.0) + 1);
+}
+
+/**
+ * @brief Starts timing a frame. Time outside any phase is charged to Draw.
+ */
+void FrameProfiler::beginFrame() {
+    double t = now();
+    current = Frame();
+    current.start = t;
+    current.inputLatencyMs = -1.0;
+    current.frameMs = lastFrameStart >= 0.0 ? (t - lastFrameStart) * 1000.0 : 0.0;
+    lastFrameStart = t;
+    lastSwitch = t;
+    depth = 0;
+    stack[depth++] = Draw;
+    inFrame = true;
+}
+
+/**
+ * @brief Finishes the current frame and adds it to the history.
+ */
+void FrameProfiler::endFrame() {
+    if (!inFrame) return;
+
+    double t = now();
+    charge(t);
+    current.workMs = (t - current.start) * 1000.0;
+    inFrame = false;
+
+    // Keep only the last historySeconds of frames
+    while (count > 0 && (count == ring.size() || recent(count - 1).start < t - historySeconds)) {
+        dropOldest();
+    }
+
+    ring[head] = current;
+    head = (head + 1) % ring.size();
+    count++;
+    if (current.frameMs > 0.0) {
+        frameHistogram[bucketFor(current.frameMs)]++;
+    }
+    workHistogram[bucketFor(current.workMs)]++;
+    if (current.inputLatencyMs >= 0.0) {
+        latencyHistogram[bucketFor(current.inputLatencyMs)]++;
+        latencyCount++;
+    }
+}
+
+/**
+ * @brief Enters a phase; the enclosing phase is paused until pop().
+ */
+void FrameProfiler::push(Phase phase) {
+    if (!inFrame || depth == MAX_DEPTH) return;
+    charge(now());
+    stack[depth++] = phase;
+}
+
+/**
+ * @brief Leaves the innermost phase.
+ */
+void FrameProfiler::pop() {
+    if (!inFrame || depth <= 1) return;
+    charge(now());
+    depth--;
+}
+
+/**
+ * @brief Records an input event; only the oldest one waiting for a present counts.
+ * @param ageSeconds How long ago the event happened, from its timestamp.
+ */
+void FrameProfiler::markInput(double ageSeconds) {
+    if (pendingInput < 0.0) {
+        pendingInput = std::max(0.0, now() - std::max(0.0, ageSeconds));
+    }
+}
+
+/**
+ * @brief Turns the pending input into the current frame's latency sample.
+ */
+void FrameProfiler::markPresented() {
+    if (pendingInput < 0.0 || !inFrame) return;
+    current.inputLatencyMs = (now() - pendingInput) * 1000.0;
+    pendingInput = -1.0;
+}
+
+/**
+ * @brief Returns a percentile of input-to-present latency over the history window.
+ */
+double FrameProfiler::inputLatencyPercentile(double fraction) const {
+    return percentileFrom(latencyHistogram, latencyCount, fraction);
+}
+
+/**
+ * @brief Returns a percentile of the frame interval over the history window.
+ */
+double FrameProfiler::framePercentile(double fraction) const {
+    size_t total = 0;
+    for (unsigned int bucket : frameHistogram) total += bucket;
+    return percentileFrom(frameHistogram, total, fraction);
+}
+
+/**
+ * @brief Returns a percentile of the frame work time over the history window.
+ */
+double FrameProfiler::workPercentile(double fraction) const {
+    return percentileFrom(workHistogram, count, fraction);
+}
+
+/**
+ * @brief Returns the most recent frame, or nullptr before the first one.
+ */
+const FrameProfiler::Frame* FrameProfiler::latest() const {
+    return count > 0 ? &recent(0) : nullptr;
+}
+
+/**
+ * @brief Returns the n-th most recent frame (0 is the latest).
+ */
+const FrameProfiler::Frame& FrameProfiler::recent(size_t n) const {
+    return ring[(head + ring.size() - 1 - n) % ring.size()];
+}
+
+/**
+ * @brief Writes the history window to a CSV file, preceded by a percentile summary.
+ * @param path Output file path.
+ * @return true if the file was written.
+ */
+bool FrameProfiler::dump(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << std::fixed << std::setprecision(3);
+    out << "# frames: " << count << " over " << historySeconds << " s\n";
+    out << "# frame_ms p50 " << framePercentile(0.50) << " p95 " << framePercentile(0.95)
+        << " p99 " << framePercentile(0.99) << "\n";
+    out << "# work_ms p50 " << workPercentile(0.50) << " p95 " << workPercentile(0.95)
+        << " p99 " << workPercentile(0.99) << "\n";
+    out << "# input_latency_ms p50 " << inputLatencyPercentile(0.50) << " p95 " << inputLatencyPercentile(0.95)
+        << " p99 " << inputLatencyPercentile(0.99) << " samples " << latencyCount << "\n";
+
+    out << "time_s,frame_ms,work_ms";
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        out << "," << phaseName(static_cast<Phase>(phase)) << "_ms";
+    }
+    out << ",input_latency_ms\n";
+
+    for (size_t n = count; n-- > 0;) {
+        const Frame& frame = recent(n);
+        out << frame.start << "," << frame.frameMs << "," << frame.workMs;
+        for (double ms : frame.phaseMs) {
+            out << "," << ms;
+        }
+        out << ",";
+        if (frame.inputLatencyMs >= 0.0) {
+            out << frame.inputLatencyMs;
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Returns the display name of a phase.
+ */
+const char* FrameProfiler::phaseName(Phase phase) {
+    switch (phase) {
+        case Input: return "input";
+        case Layout: return "layout";
+        case Text: return "text";
+        case Upload: return "upload";
+        case Draw: return "draw";
+        case Present: return "present";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Returns seconds since the profiler was created.
+ */
+double FrameProfiler::now() const {
+    return std::chrono::duration<double>(Clock::now() - origin).count();
+}
+
+/**
+ * @brief Charges the time since the last phase switch to the innermost phase.
+ */
+void FrameProfiler::charge(double timestamp) {
+    if (depth > 0) {
+        current.phaseMs[stack[depth - 1]] += (timestamp - lastSwitch) * 1000.0;
+    }
+    lastSwitch = timestamp;
+}
+
+/**
+ * @brief Removes the oldest frame from the window and its histograms.
+ */
+void FrameProfiler::dropOldest() {
+    const Frame& oldest = recent(count - 1);
+    if (oldest.frameMs > 0.0) {
+        frameHistogram[bucketFor(oldest.frameMs)]--;
+    }
+    workHistogram[bucketFor(oldest.workMs)]--;
+    if (oldest.inputLatencyMs >= 0.0) {
+        latencyHistogram[bucketFor(oldest.inputLatencyMs)]--;
+        latencyCount--;
+    }
+    count--;
+}
+
+/**
+ * @brief Maps a duration to its histogram bucket; the last bucket collects outliers.
+ */
+int FrameProfiler::bucketFor(double ms) {
+    return std::clamp(static_cast<int>(ms / BUCKET_MS), 0, HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * @brief Reads a percentile off a bucketed histogram.
+ * @return The upper edge of the bucket holding the percentile, in ms.
+ */
+double FrameProfiler::percentileFrom(const std::vector<unsigned int>& histogram, size_t total, double fraction) {
+    if (total == 0) return 0.0;
+
+    size_t rank = static_cast<size_t>(fraction * (total - 1)) + 1;
+    size_t seen = 0;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= rank) {
+            return (bucket + 1) * BUCKET_MS;
+        }
+    }
+    return HISTOGRAM_BUCKETS * BUCKET_MS;
+}
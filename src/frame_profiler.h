@@ -0,0 +1,171 @@
+/**
+ * @file frame_profiler.h
+ * @brief Declares the FrameProfiler class, which times the phases of each launcher frame.
+ *
+ * Phases nest: time spent in an inner phase (e.g. text rasterization during
+ * drawing) is charged to the inner phase only, so the per-phase numbers of
+ * a frame add up to its work time. The last few seconds of frames are kept
+ * for rolling percentiles and can be dumped to a CSV file.
+ *
+ * Input latency is measured from the moment an input event happened to the
+ * return of the first present after it, i.e. the first frame that could
+ * reflect it. Each frame carries at most one sample, from its oldest input.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class FrameProfiler
+ * @brief Per-frame phase timer with a rolling history and histograms.
+ */
+class FrameProfiler {
+public:
+    enum Phase { Input, Layout, Text, Upload, Draw, Present, PHASE_COUNT };
+
+    /**
+     * @brief Timing of one completed frame.
+     */
+    struct Frame {
+        double start;                ///< Seconds since the profiler was created.
+        double frameMs;              ///< Interval since the previous frame started.
+        double workMs;               ///< Time between beginFrame() and endFrame().
+        double phaseMs[PHASE_COUNT]; ///< Exclusive time per phase.
+        double inputLatencyMs;       ///< Input-to-present latency, or a negative value if none.
+    };
+
+    /**
+     * @brief RAII helper that charges its lifetime to a phase.
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, Phase phase) : profiler(profiler) { profiler.push(phase); }
+        ~Scope() { profiler.pop(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        FrameProfiler& profiler;
+    };
+
+    /**
+     * @brief Constructs a profiler.
+     * @param historySeconds How many seconds of frames to keep.
+     */
+    explicit FrameProfiler(double historySeconds = 10.0);
+
+    /**
+     * @brief Starts timing a frame.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Finishes the current frame and adds it to the history.
+     */
+    void endFrame();
+
+    /**
+     * @brief Enters a phase; the enclosing phase is paused until pop().
+     */
+    void push(Phase phase);
+
+    /**
+     * @brief Leaves the innermost phase.
+     */
+    void pop();
+
+    /**
+     * @brief Records that an input event arrived, if none is waiting for a present yet.
+     * @param ageSeconds How long ago the event happened, from its timestamp.
+     */
+    void markInput(double ageSeconds = 0.0);
+
+    /**
+     * @brief Closes the pending input, if any, as a latency sample of the current frame.
+     *        Call right after the present returns.
+     */
+    void markPresented();
+
+    /**
+     * @brief Returns a percentile of input-to-present latency over the history window.
+     * @param fraction Percentile as a fraction, e.g. 0.95.
+     */
+    double inputLatencyPercentile(double fraction) const;
+
+    /**
+     * @brief Returns the number of input latency samples in the history window.
+     */
+    size_t inputLatencyCount() const { return latencyCount; }
+
+    /**
+     * @brief Returns a percentile of the frame interval over the history window.
+     * @param fraction Percentile as a fraction, e.g. 0.95.
+     */
+    double framePercentile(double fraction) const;
+
+    /**
+     * @brief Returns a percentile of the frame work time over the history window.
+     * @param fraction Percentile as a fraction, e.g. 0.95.
+     */
+    double workPercentile(double fraction) const;
+
+    /**
+     * @brief Returns the most recent frame, or nullptr before the first one.
+     */
+    const Frame* latest() const;
+
+    /**
+     * @brief Returns the number of frames in the history window.
+     */
+    size_t frameCount() const { return count; }
+
+    /**
+     * @brief Returns the n-th most recent frame (0 is the latest).
+     */
+    const Frame& recent(size_t n) const;
+
+    /**
+     * @brief Writes the history window to a CSV file, preceded by a percentile summary.
+     * @param path Output file path.
+     * @return true if the file was written.
+     */
+    bool dump(const std::string& path) const;
+
+    /**
+     * @brief Returns the display name of a phase.
+     */
+    static const char* phaseName(Phase phase);
+
+private:
+    static const int HISTOGRAM_BUCKETS = 1000;     ///< 0.1 ms buckets up to 100 ms.
+    static constexpr double BUCKET_MS = 0.1;
+    static const int MAX_DEPTH = 8;
+
+    using Clock = std::chrono::steady_clock;
+
+    double historySeconds;
+    Clock::time_point origin;
+    std::vector<Frame> ring;
+    size_t head;    ///< Index the next frame is written to.
+    size_t count;
+    std::vector<unsigned int> frameHistogram;
+    std::vector<unsigned int> workHistogram;
+    std::vector<unsigned int> latencyHistogram;
+    size_t latencyCount;
+    double pendingInput;  ///< Time of the oldest input not yet presented, or negative.
+
+    Frame current;
+    bool inFrame;
+    double lastFrameStart;
+    double lastSwitch;
+    Phase stack[MAX_DEPTH];
+    int depth;
+
+    double now() const;
+    void charge(double timestamp);
+    void dropOldest();
+    static int bucketFor(double ms);
+    static double percentileFrom(const std::vector<unsigned int>& histogram, size_t total, double fraction);
+};
@@ -0,0 +1,208 @@
+/**
+ * @file frame_snapshot.cpp
+ * @brief Implements the QOI-style frame compression of FrameSnapshot.
+ */
+
+#include "frame_snapshot.h"
+#include <algorithm>
+
+namespace {
+
+// Operations, each starting with a tag byte. Frames are opaque, so alpha is not stored.
+const uint8_t OP_INDEX = 0x00;  ///< 00iiiiii: the pixel in slot i of the color cache.
+const uint8_t OP_DIFF = 0x40;   ///< 01rrggbb: each channel differs from the last pixel by -2..1.
+const uint8_t OP_LUMA = 0x80;   ///< 10gggggg, rrrrbbbb: green by -32..31, red and blue by -8..7 more than green.
+const uint8_t OP_RUN = 0xc0;    ///< 11nnnnnn: the last pixel n + 1 more times.
+const uint8_t OP_RGB = 0xfe;    ///< Followed by red, green and blue.
+const uint8_t OP_MASK = 0xc0;
+const int MAX_RUN = 62;         ///< Longer runs would collide with OP_RGB.
+const uint32_t OPAQUE = 0xff000000;
+
+/**
+ * @brief Returns the color cache slot of an ARGB8888 pixel.
+ */
+inline int cacheSlot(uint32_t pixel) {
+    uint32_t r = (pixel >> 16) & 0xff, g = (pixel >> 8) & 0xff, b = pixel & 0xff;
+    return static_cast<int>((r * 3 + g * 5 + b * 7 + 255 * 11) % 64);
+}
+
+} // namespace
+
+/**
+ * @brief Constructs an empty snapshot.
+ */
+FrameSnapshot::FrameSnapshot() : width(0), height(0) {}
+
+/**
+ * @brief Compresses the top-left part of a frame, replacing any previous one.
+ *
+ * Frames that are not ARGB8888 are converted first, which briefly takes
+ * a second copy of the frame.
+ *
+ * @return false if the frame could not be read; the snapshot is then empty.
+ */
+bool FrameSnapshot::capture(SDL_Surface* frame, int width, int height) {
+    clear();
+    if (!frame) {
+        return false;
+    }
+
+    SDL_Surface* converted = nullptr;
+    if (frame->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        converted = SDL_ConvertSurfaceFormat(frame, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!converted) {
+            return false;
+        }
+        frame = converted;
+    }
+    this->width = std::max(1, std::min(width, frame->w));
+    this->height = std::max(1, std::min(height, frame->h));
+
+    bool locked = SDL_MUSTLOCK(frame) && SDL_LockSurface(frame) == 0;
+    if (!SDL_MUSTLOCK(frame) || locked) {
+        encode(frame);
+    }
+    if (locked) {
+        SDL_UnlockSurface(frame);
+    }
+    SDL_FreeSurface(converted);
+
+    if (data.empty()) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Encodes width x height pixels of an ARGB8888 surface into data.
+ */
+void FrameSnapshot::encode(const SDL_Surface* frame) {
+    data.reserve(static_cast<size_t>(width) * height / 4);  // Grows for busy frames; trimmed below
+
+    uint32_t cache[64] = {};
+    uint32_t previous = OPAQUE;
+    int run = 0;
+    for (int y = 0; y < height; ++y) {
+        const uint32_t* row = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(frame->pixels) + y * frame->pitch);
+        for (int x = 0; x < width; ++x) {
+            const uint32_t pixel = row[x] | OPAQUE;
+            if (pixel == previous) {
+                if (++run == MAX_RUN) {
+                    data.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                data.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+                run = 0;
+            }
+
+            const int slot = cacheSlot(pixel);
+            if (cache[slot] == pixel) {
+                data.push_back(static_cast<uint8_t>(OP_INDEX | slot));
+            } else {
+                cache[slot] = pixel;
+                // Channel differences wrap around, as in the decoder
+                const int dr = static_cast<int8_t>(((pixel >> 16) & 0xff) - ((previous >> 16) & 0xff));
+                const int dg = static_cast<int8_t>(((pixel >> 8) & 0xff) - ((previous >> 8) & 0xff));
+                const int db = static_cast<int8_t>((pixel & 0xff) - (previous & 0xff));
+                const int drg = dr - dg, dbg = db - dg;
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    data.push_back(static_cast<uint8_t>(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                    data.push_back(static_cast<uint8_t>(OP_LUMA | (dg + 32)));
+                    data.push_back(static_cast<uint8_t>((drg + 8) << 4 | (dbg + 8)));
+                } else {
+                    data.push_back(OP_RGB);
+                    data.push_back(static_cast<uint8_t>(pixel >> 16));
+                    data.push_back(static_cast<uint8_t>(pixel >> 8));
+                    data.push_back(static_cast<uint8_t>(pixel));
+                }
+            }
+            previous = pixel;
+        }
+    }
+    if (run > 0) {
+        data.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+    }
+    data.shrink_to_fit();
+}
+
+/**
+ * @brief Decodes the snapshot into a new ARGB8888 surface.
+ * @return The surface (owned by the caller), or nullptr if empty or corrupt.
+ */
+SDL_Surface* FrameSnapshot::expand() const {
+    if (data.empty()) {
+        return nullptr;
+    }
+    SDL_Surface* frame = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!frame) {
+        return nullptr;
+    }
+
+    uint32_t cache[64] = {};
+    uint32_t pixel = OPAQUE;
+    int run = 0;
+    size_t in = 0;
+    for (int y = 0; y < height; ++y) {
+        uint32_t* row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(frame->pixels) + y * frame->pitch);
+        for (int x = 0; x < width; ++x) {
+            if (run > 0) {
+                --run;
+                row[x] = pixel;
+                continue;
+            }
+            if (in >= data.size()) {
+                SDL_FreeSurface(frame);
+                return nullptr;
+            }
+
+            const uint8_t op = data[in++];
+            if (op == OP_RGB) {
+                if (in + 3 > data.size()) {
+                    SDL_FreeSurface(frame);
+                    return nullptr;
+                }
+                pixel = OPAQUE | static_cast<uint32_t>(data[in]) << 16 | static_cast<uint32_t>(data[in + 1]) << 8 | data[in + 2];
+                in += 3;
+            } else if ((op & OP_MASK) == OP_INDEX) {
+                pixel = cache[op];
+            } else if ((op & OP_MASK) == OP_DIFF) {
+                int r = static_cast<int>((pixel >> 16) & 0xff) + ((op >> 4) & 3) - 2;
+                int g = static_cast<int>((pixel >> 8) & 0xff) + ((op >> 2) & 3) - 2;
+                int b = static_cast<int>(pixel & 0xff) + (op & 3) - 2;
+                pixel = OPAQUE | static_cast<uint32_t>(r & 0xff) << 16 | static_cast<uint32_t>(g & 0xff) << 8 | (b & 0xff);
+            } else if ((op & OP_MASK) == OP_LUMA) {
+                if (in >= data.size()) {
+                    SDL_FreeSurface(frame);
+                    return nullptr;
+                }
+                const int dg = (op & 0x3f) - 32;
+                const uint8_t next = data[in++];
+                int r = static_cast<int>((pixel >> 16) & 0xff) + dg + (next >> 4) - 8;
+                int g = static_cast<int>((pixel >> 8) & 0xff) + dg;
+                int b = static_cast<int>(pixel & 0xff) + dg + (next & 0x0f) - 8;
+                pixel = OPAQUE | static_cast<uint32_t>(r & 0xff) << 16 | static_cast<uint32_t>(g & 0xff) << 8 | (b & 0xff);
+            } else {
+                row[x] = pixel;
+                run = op & 0x3f;  // This pixel was the first of n + 1
+                continue;
+            }
+            cache[cacheSlot(pixel)] = pixel;
+            row[x] = pixel;
+        }
+    }
+    return frame;
+}
+
+/**
+ * @brief Frees the compressed frame.
+ */
+void FrameSnapshot::clear() {
+    std::vector<uint8_t>().swap(data);
+    width = 0;
+    height = 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file frame_snapshot.h
+ * @brief Declares FrameSnapshot, a losslessly compressed copy of one menu frame.
+ *
+ * The launcher keeps its last menu frame while a game runs, to put it
+ * back on screen the instant the game exits. Held raw, a 4K frame costs
+ * 33 MB for the whole session. Menu frames are mostly flat background,
+ * text and a few covers, so they are stored with a QOI-style encoding
+ * (runs, a 64-entry color cache and small deltas from the previous pixel)
+ * that typically shrinks them by an order of magnitude and encodes or
+ * decodes a 4K frame in tens of milliseconds.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class FrameSnapshot
+ * @brief Compresses an opaque frame in memory and expands it back into a surface.
+ */
+class FrameSnapshot {
+public:
+    FrameSnapshot();
+
+    /**
+     * @brief Compresses the top-left part of a frame, replacing any previous one.
+     * @param frame The frame, in any 32-bit format SDL can convert to ARGB8888.
+     * @param width Width of the part kept, clamped to the frame.
+     * @param height Height of the part kept, clamped to the frame.
+     * @return false if the frame could not be read; the snapshot is then empty.
+     */
+    bool capture(SDL_Surface* frame, int width, int height);
+
+    /**
+     * @brief Decodes the snapshot into a new ARGB8888 surface.
+     * @return The surface (owned by the caller), or nullptr if empty or corrupt.
+     */
+    SDL_Surface* expand() const;
+
+    /**
+     * @brief Frees the compressed frame.
+     */
+    void clear();
+
+    bool empty() const { return data.empty(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    /**
+     * @brief Returns the size of the compressed frame in bytes.
+     */
+    size_t getBytes() const { return data.capacity(); }
+
+private:
+    std::vector<uint8_t> data;
+    int width;
+    int height;
+
+    void encode(const SDL_Surface* frame);
+};
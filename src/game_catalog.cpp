@@ -0,0 +1,183 @@
+/**
+ * @file game_catalog.cpp
+ * @brief Implements the string pool and the columnar GameCatalog.
+ */
+
+#include "game_catalog.h"
+
+namespace {
+
+/**
+ * @brief Returns the heap bytes owned by a string, zero when it fits the small-string buffer.
+ */
+size_t stringHeapBytes(const std::string& text) {
+    static const size_t inlineCapacity = std::string().capacity();
+    return text.capacity() > inlineCapacity ? text.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Returns the bytes reserved by a column of plain values.
+ */
+template <typename T>
+size_t columnBytes(const std::vector<T>& column) {
+    return column.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Returns the bytes reserved by a column of strings, including their heap buffers.
+ */
+size_t stringColumnBytes(const std::vector<std::string>& column) {
+    size_t bytes = columnBytes(column);
+    for (const std::string& text : column) {
+        bytes += stringHeapBytes(text);
+    }
+    return bytes;
+}
+
+} // namespace
+
+/**
+ * @brief Returns the id of text, adding it on first use.
+ */
+uint32_t StringPool::intern(const std::string& text) {
+    auto it = ids.find(text);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    auto inserted = ids.emplace(text, id).first;
+    strings.push_back(&inserted->first);
+    return id;
+}
+
+/**
+ * @brief Forgets every string. Ids handed out before are no longer valid.
+ */
+void StringPool::clear() {
+    ids.clear();
+    strings.clear();
+}
+
+/**
+ * @brief Returns the approximate heap footprint of the pool in bytes.
+ */
+size_t StringPool::memoryBytes() const {
+    // Each hash node holds the key/value pair, a next pointer and the cached hash
+    const size_t nodeBytes = sizeof(std::pair<const std::string, uint32_t>) + 2 * sizeof(void*);
+    size_t bytes = ids.bucket_count() * sizeof(void*) + columnBytes(strings);
+    for (const auto& entry : ids) {
+        bytes += nodeBytes + stringHeapBytes(entry.first);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Appends a game and returns its id.
+ *
+ * Repeating fields go through their string pools; titles, filenames,
+ * descriptions and IGDB links are unique per game and stored as they are.
+ */
+GameId GameCatalog::add(const GameMetadata& game) {
+    GameId id = static_cast<GameId>(titles.size());
+
+    titles.push_back(game.title);
+    imagePathIds.push_back(imagePaths.intern(game.imagePath));
+    yearIds.push_back(years.intern(game.releaseYear));
+    publisherIds.push_back(publishers.intern(game.publisher));
+    genreIds.push_back(genres.intern(game.genre));
+    detailIds.push_back(detailLines.intern(game.releaseYear + " | " + game.publisher + " | " + game.genre));
+    previewIds.push_back(previews.intern(game.previewHash));
+    dominantColors.push_back(game.dominantColor);
+    flags.push_back(game.igdbUrl.empty() ? 0 : FLAG_HAS_IGDB_URL);
+
+    filenames.push_back(game.filename);
+    descriptions.push_back(game.description);
+    igdbUrls.push_back(game.igdbUrl);
+    return id;
+}
+
+/**
+ * @brief Reserves every column for a number of games.
+ */
+void GameCatalog::reserve(size_t count) {
+    titles.reserve(count);
+    imagePathIds.reserve(count);
+    yearIds.reserve(count);
+    publisherIds.reserve(count);
+    genreIds.reserve(count);
+    detailIds.reserve(count);
+    previewIds.reserve(count);
+    dominantColors.reserve(count);
+    flags.reserve(count);
+    filenames.reserve(count);
+    descriptions.reserve(count);
+    igdbUrls.reserve(count);
+}
+
+/**
+ * @brief Drops every game and the string pools.
+ */
+void GameCatalog::clear() {
+    titles.clear();
+    imagePathIds.clear();
+    yearIds.clear();
+    publisherIds.clear();
+    genreIds.clear();
+    detailIds.clear();
+    previewIds.clear();
+    dominantColors.clear();
+    flags.clear();
+    filenames.clear();
+    descriptions.clear();
+    igdbUrls.clear();
+    imagePaths.clear();
+    years.clear();
+    publishers.clear();
+    genres.clear();
+    detailLines.clear();
+    previews.clear();
+}
+
+/**
+ * @brief Reassembles the full record of a game.
+ */
+GameMetadata GameCatalog::toMetadata(GameId id) const {
+    GameMetadata game;
+    game.filename = filename(id);
+    game.title = title(id);
+    game.description = description(id);
+    game.releaseYear = releaseYear(id);
+    game.publisher = publisher(id);
+    game.genre = genre(id);
+    game.imagePath = imagePath(id);
+    game.igdbUrl = igdbUrl(id);
+    game.previewHash = previewHash(id);
+    game.dominantColor = dominantColor(id);
+    return game;
+}
+
+/**
+ * @brief Returns the approximate heap footprint of the catalog in bytes.
+ */
+size_t GameCatalog::memoryBytes() const {
+    size_t bytes = stringColumnBytes(titles) + columnBytes(imagePathIds) + columnBytes(yearIds) +
+                   columnBytes(publisherIds) + columnBytes(genreIds) + columnBytes(detailIds) + columnBytes(flags);
+    bytes += columnBytes(previewIds) + columnBytes(dominantColors);
+    bytes += stringColumnBytes(filenames) + stringColumnBytes(descriptions) + stringColumnBytes(igdbUrls);
+    bytes += imagePaths.memoryBytes() + years.memoryBytes() + publishers.memoryBytes() + genres.memoryBytes() +
+             detailLines.memoryBytes() + previews.memoryBytes();
+    return bytes;
+}
+
+/**
+ * @brief Returns the footprint of a record stored as a plain GameMetadata,
+ *        for comparison with memoryBytes().
+ */
+size_t GameCatalog::metadataBytes(const GameMetadata& game) {
+    return sizeof(GameMetadata) +
+           stringHeapBytes(game.filename) + stringHeapBytes(game.title) +
+           stringHeapBytes(game.description) + stringHeapBytes(game.releaseYear) +
+           stringHeapBytes(game.publisher) + stringHeapBytes(game.genre) +
+           stringHeapBytes(game.imagePath) + stringHeapBytes(game.igdbUrl) +
+           stringHeapBytes(game.previewHash);
+}
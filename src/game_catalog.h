@@ -0,0 +1,139 @@
+/**
+ * @file game_catalog.h
+ * @brief Declares GameCatalog, a column-oriented store of game metadata.
+ *
+ * The launcher used to keep one GameMetadata (eight std::strings) per game.
+ * Publisher, genre, release year and cover path repeat across thousands of
+ * games, so they are interned in string pools and stored as integer ids.
+ * Fields read every frame (title, cover, the small ids and flags) live in
+ * their own tightly packed columns; long, rarely touched text such as
+ * descriptions, filenames and URLs is kept in separate cold columns.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "game_metadata.h"
+
+/// Compact, stable identifier of a game: its position in the catalog.
+using GameId = uint32_t;
+
+/**
+ * @class StringPool
+ * @brief Stores each distinct string once and hands out dense integer ids.
+ */
+class StringPool {
+public:
+    /**
+     * @brief Returns the id of text, adding it on first use.
+     */
+    uint32_t intern(const std::string& text);
+
+    /**
+     * @brief Returns the string for an id. References stay valid until clear().
+     */
+    const std::string& get(uint32_t id) const { return *strings[id]; }
+
+    size_t size() const { return strings.size(); }
+    void clear();
+
+    /**
+     * @brief Returns the approximate heap footprint of the pool in bytes.
+     */
+    size_t memoryBytes() const;
+
+private:
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<const std::string*> strings;  ///< Keys of ids; node-based, so never moved.
+};
+
+/**
+ * @class GameCatalog
+ * @brief Struct-of-arrays game library with interned publisher, genre, year and cover path.
+ */
+class GameCatalog {
+public:
+    /**
+     * @brief Appends a game and returns its id.
+     */
+    GameId add(const GameMetadata& game);
+
+    void reserve(size_t count);
+    void clear();
+    size_t size() const { return titles.size(); }
+    bool empty() const { return titles.empty(); }
+
+    // Hot columns, read for every visible row each frame
+    const std::string& title(GameId id) const { return titles[id]; }
+    const std::string& imagePath(GameId id) const { return imagePaths.get(imagePathIds[id]); }
+    const std::string& releaseYear(GameId id) const { return years.get(yearIds[id]); }
+    const std::string& publisher(GameId id) const { return publishers.get(publisherIds[id]); }
+    const std::string& genre(GameId id) const { return genres.get(genreIds[id]); }
+    bool hasIgdbUrl(GameId id) const { return (flags[id] & FLAG_HAS_IGDB_URL) != 0; }
+
+    /**
+     * @brief Returns the BlurHash of the game's cover, or an empty string if it has none.
+     *
+     * Games sharing a cover share its preview, so previews are interned too.
+     */
+    const std::string& previewHash(GameId id) const { return previews.get(previewIds[id]); }
+    uint32_t dominantColor(GameId id) const { return dominantColors[id]; }
+
+    /**
+     * @brief Returns the "year | publisher | genre" line shown under the title.
+     *
+     * Built once when the game is added; the same combination is shared by
+     * many games, so it is interned like the fields it is made of.
+     */
+    const std::string& details(GameId id) const { return detailLines.get(detailIds[id]); }
+
+    // Cold columns
+    const std::string& filename(GameId id) const { return filenames[id]; }
+    const std::string& description(GameId id) const { return descriptions[id]; }
+    const std::string& igdbUrl(GameId id) const { return igdbUrls[id]; }
+
+    /**
+     * @brief Reassembles the full record of a game.
+     */
+    GameMetadata toMetadata(GameId id) const;
+
+    /**
+     * @brief Returns the approximate heap footprint of the catalog in bytes.
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * @brief Returns the footprint of a record stored as a plain GameMetadata,
+     *        for comparison with memoryBytes().
+     */
+    static size_t metadataBytes(const GameMetadata& game);
+
+private:
+    static const uint8_t FLAG_HAS_IGDB_URL = 1;
+
+    // Hot
+    std::vector<std::string> titles;
+    std::vector<uint32_t> imagePathIds;
+    std::vector<uint32_t> yearIds;
+    std::vector<uint32_t> publisherIds;
+    std::vector<uint32_t> genreIds;
+    std::vector<uint32_t> detailIds;
+    std::vector<uint32_t> previewIds;
+    std::vector<uint32_t> dominantColors;
+    std::vector<uint8_t> flags;
+
+    // Cold
+    std::vector<std::string> filenames;
+    std::vector<std::string> descriptions;
+    std::vector<std::string> igdbUrls;
+
+    StringPool imagePaths;
+    StringPool years;
+    StringPool publishers;
+    StringPool genres;
+    StringPool detailLines;
+    StringPool previews;
+};
@@ -0,0 +1,21 @@
+/**
+ * @file game_details.h
+ * @brief Declares GameDetails, the extended IGDB fields shown in the detail pane.
+ *
+ * The list only needs what GameMetadata holds. Everything here is fetched
+ * per game when its detail pane is first opened and is cached apart from
+ * the library, so the bulk metadata fetch stays small.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+struct GameDetails {
+    std::string storyline;
+    int rating = -1;                         ///< IGDB total rating, 0-100, or -1 if unrated.
+    int ratingCount = 0;                     ///< Number of ratings behind the total.
+    std::vector<std::string> screenshots;    ///< Local paths of square screenshot thumbnails.
+    std::vector<std::string> artworks;       ///< Local paths of square artwork thumbnails.
+    std::vector<std::string> similarGames;   ///< Titles of similar games.
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
 struct GameMetadata {
@@ -10,4 +11,6 @@ struct GameMetadata {
     std::string genre;
     std::string imagePath;
     std::string igdbUrl;
+    std::string previewHash;     // BlurHash of the cover, computed when it is downloaded
+    uint32_t dominantColor = 0;  // Most common cover color as 0xAARRGGBB, 0 if unknown
 }; 
\ No newline at end of file
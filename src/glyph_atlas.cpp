@@ -0,0 +1,261 @@
+/**
+ * @file glyph_atlas.cpp
+ * @brief Implements baking and drawing of GlyphAtlas.
+ */
+
+#include "glyph_atlas.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+GlyphAtlas::GlyphAtlas()
+    : pixelSize(0), height(0), atlasWidth(0), glyphs(nullptr), kerning(nullptr), coverage(nullptr) {}
+
+/**
+ * @brief Returns the asset pack entry name of the atlas for a pixel size.
+ */
+std::string GlyphAtlas::entryName(int pixelSize) {
+    return "glyphs/" + std::to_string(pixelSize);
+}
+
+/**
+ * @brief Rasterizes printable ASCII with a font and encodes the atlas.
+ *
+ * Each glyph is rendered on its own the way SDL_ttf renders a string, then
+ * cropped to its visible pixels. Glyphs are packed on shelves one line high.
+ */
+std::vector<uint8_t> GlyphAtlas::bake(TTF_Font* font, int pixelSize) {
+    const SDL_Color white = {255, 255, 255, 255};
+    const int lineHeight = TTF_FontHeight(font);
+
+    std::vector<GlyphRecord> records(GLYPH_COUNT);
+    std::vector<std::vector<uint8_t>> bitmaps(GLYPH_COUNT);
+    int shelfX = 0, shelfY = 0;
+
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        const Uint16 ch = static_cast<Uint16>(FIRST_CHAR + i);
+        GlyphRecord& record = records[i];
+        std::memset(&record, 0, sizeof(record));
+
+        int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) != 0) {
+            std::cerr << "Font has no glyph for '" << static_cast<char>(ch) << "'" << std::endl;
+            return {};
+        }
+        record.advance = static_cast<int16_t>(advance);
+
+        SDL_Surface* rendered = ch == ' ' ? nullptr : TTF_RenderGlyph_Blended(font, ch, white);
+        SDL_Surface* surface = rendered ? SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+        if (rendered) SDL_FreeSurface(rendered);
+        if (!surface) {
+            continue;  // Blank glyph: nothing to draw, only the advance matters
+        }
+
+        // Crop to the pixels with coverage
+        int left = surface->w, top = surface->h, right = -1, bottom = -1;
+        for (int y = 0; y < surface->h; ++y) {
+            const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(surface->pixels) + y * surface->pitch);
+            for (int x = 0; x < surface->w; ++x) {
+                if (row[x] >> 24) {
+                    left = std::min(left, x);
+                    right = std::max(right, x);
+                    top = std::min(top, y);
+                    bottom = std::max(bottom, y);
+                }
+            }
+        }
+
+        if (right >= left) {
+            record.w = static_cast<uint16_t>(right - left + 1);
+            record.h = static_cast<uint16_t>(bottom - top + 1);
+            // SDL_ttf shifts a string right when its first glyph starts left of the pen
+            record.offsetX = static_cast<int16_t>(left - std::max(0, -minx));
+            record.offsetY = static_cast<int16_t>(top);
+
+            if (shelfX + record.w > ATLAS_WIDTH) {
+                shelfX = 0;
+                shelfY += lineHeight + 1;
+            }
+            record.x = static_cast<uint16_t>(shelfX);
+            record.y = static_cast<uint16_t>(shelfY);
+            shelfX += record.w + 1;
+
+            std::vector<uint8_t>& bitmap = bitmaps[i];
+            bitmap.resize(static_cast<size_t>(record.w) * record.h);
+            for (int y = 0; y < record.h; ++y) {
+                const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(surface->pixels) +
+                                                                    (top + y) * surface->pitch);
+                for (int x = 0; x < record.w; ++x) {
+                    bitmap[y * record.w + x] = static_cast<uint8_t>(row[left + x] >> 24);
+                }
+            }
+        }
+        SDL_FreeSurface(surface);
+    }
+    const int atlasHeight = shelfY + lineHeight + 1;
+
+    AtlasHeader header = {MAGIC, static_cast<uint16_t>(pixelSize), static_cast<uint16_t>(lineHeight),
+                          static_cast<uint16_t>(GLYPH_COUNT), static_cast<uint16_t>(ATLAS_WIDTH),
+                          static_cast<uint16_t>(atlasHeight), 0};
+    const size_t kerningBytes = GLYPH_COUNT * GLYPH_COUNT;
+    std::vector<uint8_t> data(sizeof(AtlasHeader) + records.size() * sizeof(GlyphRecord) + kerningBytes +
+                              static_cast<size_t>(ATLAS_WIDTH) * atlasHeight);
+
+    uint8_t* out = data.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, records.data(), records.size() * sizeof(GlyphRecord));
+    out += records.size() * sizeof(GlyphRecord);
+
+    for (int left = 0; left < GLYPH_COUNT; ++left) {
+        for (int right = 0; right < GLYPH_COUNT; ++right) {
+            int kern = TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(FIRST_CHAR + left),
+                                                    static_cast<Uint16>(FIRST_CHAR + right));
+            out[left * GLYPH_COUNT + right] = static_cast<uint8_t>(static_cast<int8_t>(std::clamp(kern, -128, 127)));
+        }
+    }
+    out += kerningBytes;
+
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        const GlyphRecord& record = records[i];
+        for (int y = 0; y < record.h; ++y) {
+            std::memcpy(out + (record.y + y) * ATLAS_WIDTH + record.x, bitmaps[i].data() + y * record.w, record.w);
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Uses an encoded atlas in place.
+ */
+bool GlyphAtlas::load(const uint8_t* data, size_t size) {
+    reset();
+    if (!data || size < sizeof(AtlasHeader)) {
+        return false;
+    }
+
+    AtlasHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const size_t tableBytes = static_cast<size_t>(header.glyphCount) * sizeof(GlyphRecord);
+    const size_t kerningBytes = static_cast<size_t>(header.glyphCount) * header.glyphCount;
+    const size_t coverageBytes = static_cast<size_t>(header.atlasWidth) * header.atlasHeight;
+    if (header.magic != MAGIC || header.glyphCount != GLYPH_COUNT ||
+        size < sizeof(AtlasHeader) + tableBytes + kerningBytes + coverageBytes) {
+        std::cerr << "Ignoring invalid glyph atlas" << std::endl;
+        return false;
+    }
+
+    const GlyphRecord* table = reinterpret_cast<const GlyphRecord*>(data + sizeof(AtlasHeader));
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        if (table[i].x + table[i].w > header.atlasWidth || table[i].y + table[i].h > header.atlasHeight) {
+            std::cerr << "Ignoring corrupt glyph atlas" << std::endl;
+            return false;
+        }
+    }
+
+    pixelSize = header.pixelSize;
+    height = header.height;
+    atlasWidth = header.atlasWidth;
+    glyphs = table;
+    kerning = reinterpret_cast<const int8_t*>(data + sizeof(AtlasHeader) + tableBytes);
+    coverage = data + sizeof(AtlasHeader) + tableBytes + kerningBytes;
+    return true;
+}
+
+/**
+ * @brief Forgets the loaded atlas.
+ */
+void GlyphAtlas::reset() {
+    pixelSize = 0;
+    height = 0;
+    atlasWidth = 0;
+    glyphs = nullptr;
+    kerning = nullptr;
+    coverage = nullptr;
+}
+
+/**
+ * @brief Returns true if every character of text is in the atlas.
+ */
+bool GlyphAtlas::covers(const std::string& text) const {
+    if (!glyphs) {
+        return false;
+    }
+    for (char c : text) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (u < FIRST_CHAR || u >= FIRST_CHAR + GLYPH_COUNT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Renders text from the atlas.
+ *
+ * The pen advances and kerns exactly as the baking font did, and the
+ * surface is widened where glyphs overhang the pen on either side.
+ * Overlapping coverage is combined with max(), as SDL_ttf does.
+ */
+SDL_Surface* GlyphAtlas::render(const std::string& text, const SDL_Color& color) const {
+    if (!covers(text)) {
+        return nullptr;
+    }
+
+    // First pass: horizontal extent
+    int pen = 0, minX = 0, maxX = 0, previous = -1;
+    for (char c : text) {
+        int index = static_cast<unsigned char>(c) - FIRST_CHAR;
+        if (previous >= 0) {
+            pen += kerning[previous * GLYPH_COUNT + index];
+        }
+        const GlyphRecord& glyph = glyphs[index];
+        if (glyph.w > 0) {
+            minX = std::min(minX, pen + glyph.offsetX);
+            maxX = std::max(maxX, pen + glyph.offsetX + glyph.w);
+        }
+        pen += glyph.advance;
+        maxX = std::max(maxX, pen);
+        previous = index;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, std::max(1, maxX - minX), height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return nullptr;
+    }
+
+    // Transparent pixels carry the text color too, so filtering never darkens edges
+    const Uint32 rgb = (static_cast<Uint32>(color.r) << 16) | (static_cast<Uint32>(color.g) << 8) | color.b;
+    SDL_FillRect(surface, nullptr, rgb);
+
+    Uint32 alphaOf[256];
+    for (int i = 0; i < 256; ++i) {
+        alphaOf[i] = static_cast<Uint32>((i * color.a + 127) / 255) << 24;
+    }
+
+    Uint8* pixels = static_cast<Uint8*>(surface->pixels);
+    pen = -minX;
+    previous = -1;
+    for (char c : text) {
+        int index = static_cast<unsigned char>(c) - FIRST_CHAR;
+        if (previous >= 0) {
+            pen += kerning[previous * GLYPH_COUNT + index];
+        }
+        const GlyphRecord& glyph = glyphs[index];
+        const int x0 = pen + glyph.offsetX;
+        const int rows = std::min<int>(glyph.h, height - glyph.offsetY);
+        for (int y = std::max(0, -glyph.offsetY); y < rows; ++y) {
+            const uint8_t* src = coverage + (glyph.y + y) * atlasWidth + glyph.x;
+            Uint32* dst = reinterpret_cast<Uint32*>(pixels + (glyph.offsetY + y) * surface->pitch) + x0;
+            for (int x = 0; x < glyph.w; ++x) {
+                Uint32 alpha = alphaOf[src[x]];
+                if (alpha > (dst[x] & 0xff000000u)) {
+                    dst[x] = alpha | rgb;
+                }
+            }
+        }
+        pen += glyph.advance;
+        previous = index;
+    }
+    return surface;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file glyph_atlas.h
+ * @brief Declares GlyphAtlas, printable ASCII pre-rasterized at one font size.
+ *
+ * Rasterizing text with SDL_ttf at startup makes FreeType render every
+ * glyph on screen before the first frame. The asset packer bakes the
+ * coverage of each printable ASCII glyph, its placement and the kerning
+ * between every pair once at build time. At run time text surfaces are
+ * assembled from that coverage, which is a handful of byte copies per
+ * glyph, and SDL_ttf is only needed for other sizes and non-ASCII text.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class GlyphAtlas
+ * @brief Composes text surfaces from baked glyph coverage.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+
+    /**
+     * @brief Returns the asset pack entry name of the atlas for a pixel size.
+     */
+    static std::string entryName(int pixelSize);
+
+    /**
+     * @brief Rasterizes printable ASCII with a font and encodes the atlas.
+     * @param font Font opened at the size to bake.
+     * @param pixelSize Point size the font was opened at, recorded in the atlas.
+     * @return The encoded atlas, or an empty vector on failure.
+     */
+    static std::vector<uint8_t> bake(TTF_Font* font, int pixelSize);
+
+    /**
+     * @brief Uses an encoded atlas in place. The data must outlive the atlas.
+     * @return false if the data is not a valid atlas; the atlas is then empty.
+     */
+    bool load(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Forgets the loaded atlas.
+     */
+    void reset();
+
+    bool isLoaded() const { return glyphs != nullptr; }
+    int getPixelSize() const { return pixelSize; }
+
+    /**
+     * @brief Returns true if every character of text is in the atlas.
+     */
+    bool covers(const std::string& text) const;
+
+    /**
+     * @brief Renders text like TTF_RenderText_Blended: an ARGB8888 surface one
+     *        line high, filled with the color and with glyph coverage as alpha.
+     * @return The surface (owned by the caller), or nullptr if text is not covered.
+     */
+    SDL_Surface* render(const std::string& text, const SDL_Color& color) const;
+
+private:
+    static const uint32_t MAGIC = 0x46594c47;  // "GLYF"
+    static const int FIRST_CHAR = 32;
+    static const int GLYPH_COUNT = 95;         ///< ' ' through '~'
+    static const int ATLAS_WIDTH = 512;
+
+    struct AtlasHeader {
+        uint32_t magic;
+        uint16_t pixelSize;
+        uint16_t height;
+        uint16_t glyphCount;
+        uint16_t atlasWidth;
+        uint16_t atlasHeight;
+        uint16_t reserved;
+    };
+
+    /// Where a glyph's coverage sits in the atlas and where it goes relative to the pen
+    struct GlyphRecord {
+        uint16_t x;
+        uint16_t y;
+        uint16_t w;
+        uint16_t h;
+        int16_t offsetX;
+        int16_t offsetY;
+        int16_t advance;
+        int16_t reserved;
+    };
+
+    int pixelSize;
+    int height;
+    int atlasWidth;
+    const GlyphRecord* glyphs;
+    const int8_t* kerning;     ///< GLYPH_COUNT x GLYPH_COUNT adjustments, left glyph major.
+    const uint8_t* coverage;   ///< atlasWidth-wide 8-bit coverage.
+};
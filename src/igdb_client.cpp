@@ -9,6 +9,9 @@
  */
 
 #include "igdb_client.h"
+#include "asset_pack.h"
+#include "cover_preview.h"
+#include <cctype>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
@@ -289,8 +292,8 @@ GameMetadata IGDBClient::extractMetadataFromFilename(const std::string& filename
     metadata.genre = "Not Found";
     metadata.igdbUrl = "";  // No URL for games not found in IGDB
     
-    // Use the default "not found" image from assets directory
-    metadata.imagePath = "../assets/not_found.png";
+    // Use the built-in "not found" art from the asset pack
+    metadata.imagePath = AssetPack::PLACEHOLDER_URI;
     
     return metadata;
 }
@@ -302,6 +305,7 @@ GameMetadata IGDBClient::extractMetadataFromFilename(const std::string& filename
  * @return GameMetadata from game
  */
 GameMetadata IGDBClient::fetchGameMetadata(const std::string& game_name) {
+    std::lock_guard<std::mutex> lock(curlMutex);
     GameMetadata metadata;
     metadata.filename = game_name;
     
@@ -431,6 +435,8 @@ GameMetadata IGDBClient::fetchGameMetadata(const std::string& game_name) {
                 std::string image_path = "images/" + clean_name + ".png";
                 if (downloadGameCover(cover_url, image_path)) {
                     metadata.imagePath = image_path;
+                    // Summarize the cover now so the list can paint it before the file is ever decoded
+                    CoverPreview::compute(image_path, metadata.previewHash, metadata.dominantColor);
                 }
             } catch (const std::exception& e) {
                 std::cerr << "Failed to handle cover image: " << e.what() << std::endl;
@@ -447,4 +453,102 @@ GameMetadata IGDBClient::fetchGameMetadata(const std::string& game_name) {
     }
 
     return metadata;
-} 
\ No newline at end of file
+} 
+
+/**
+ * @brief Returns the IGDB slug at the end of a game page URL.
+ *
+ * @param igdb_url A URL such as https://www.igdb.com/games/super-mario-bros
+ * @return The slug, or an empty string if the URL does not end in one.
+ */
+std::string IGDBClient::slugFromUrl(const std::string& igdb_url) {
+    size_t slash = igdb_url.find_last_of('/');
+    std::string slug = slash == std::string::npos ? igdb_url : igdb_url.substr(slash + 1);
+
+    // Slugs are lowercase words joined by dashes; anything else would need escaping in a query
+    for (char c : slug) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (!std::islower(u) && !std::isdigit(u) && c != '-') {
+            return "";
+        }
+    }
+    return slug;
+}
+
+/**
+ * @brief Fetches the extended fields of one game for its detail pane.
+ *
+ * Screenshots and artworks are downloaded as IGDB's square thumbnails
+ * into images/details, skipping files that are already there, so they
+ * go through the same thumbnail atlases as covers.
+ *
+ * @param igdb_url The game's IGDB page, as stored in its metadata.
+ * @param details Receives the storyline, rating, image paths and similar titles.
+ * @return True if IGDB returned the game, false otherwise.
+ */
+bool IGDBClient::fetchGameDetails(const std::string& igdb_url, GameDetails& details) {
+    std::lock_guard<std::mutex> lock(curlMutex);
+    std::string slug = slugFromUrl(igdb_url);
+    if (access_token.empty() || slug.empty()) {
+        return false;
+    }
+
+    std::string query = "fields storyline,total_rating,total_rating_count,screenshots.image_id,"
+                        "artworks.image_id,similar_games.name; where slug = \"" + slug + "\";";
+    std::string response = makeIGDBRequest("games", query);
+    if (response.empty()) {
+        return false;
+    }
+
+    try {
+        auto json = nlohmann::json::parse(response);
+        if (!json.is_array() || json.empty()) {
+            std::cout << "No IGDB details found for: " << slug << std::endl;
+            return false;
+        }
+        const auto& game = json[0];
+
+        details.storyline = game.value("storyline", "");
+        if (game.contains("total_rating") && game["total_rating"].is_number()) {
+            details.rating = static_cast<int>(game["total_rating"].get<double>() + 0.5);
+            details.ratingCount = game.value("total_rating_count", 0);
+        }
+
+        if (game.contains("similar_games") && game["similar_games"].is_array()) {
+            for (const auto& similar : game["similar_games"]) {
+                if (similar.contains("name") && similar["name"].is_string()) {
+                    details.similarGames.push_back(similar["name"].get<std::string>());
+                }
+            }
+        }
+
+        try {
+            fs::create_directories("images/details");
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to create details image directory: " << e.what() << std::endl;
+        }
+
+        auto downloadImages = [this, &game](const char* field, std::vector<std::string>& paths) {
+            if (!game.contains(field) || !game[field].is_array()) {
+                return;
+            }
+            for (const auto& image : game[field]) {
+                if (paths.size() >= MAX_DETAIL_IMAGES) break;
+                if (!image.contains("image_id") || !image["image_id"].is_string()) continue;
+
+                const std::string id = image["image_id"].get<std::string>();
+                const std::string path = "images/details/" + id + ".jpg";
+                if (fs::exists(path) ||
+                    downloadGameCover("https://images.igdb.com/igdb/image/upload/t_thumb/" + id + ".jpg", path)) {
+                    paths.push_back(path);
+                }
+            }
+        };
+        downloadImages("screenshots", details.screenshots);
+        downloadImages("artworks", details.artworks);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to parse game details: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
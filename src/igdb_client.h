@@ -9,9 +9,11 @@
  */
 
 #pragma once
+#include <mutex>
 #include <string>
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
+#include "game_details.h"
 #include "game_metadata.h"
 
 class IGDBClient {
@@ -22,9 +24,14 @@ public:
     bool init(const std::string& client_id, const std::string& client_secret);
     GameMetadata fetchGameMetadata(const std::string& game_name);
     bool downloadGameCover(const std::string& url, const std::string& output_path);
+    bool fetchGameDetails(const std::string& igdb_url, GameDetails& details);
+    static std::string slugFromUrl(const std::string& igdb_url);
 
 private:
+    static const size_t MAX_DETAIL_IMAGES = 6;  ///< Screenshots and artworks kept per game, each
+
     CURL* curl;
+    std::mutex curlMutex;  ///< The one handle serves the library fetch and the detail worker
     std::string access_token;
     std::string client_id;
     std::string client_secret;
@@ -0,0 +1,289 @@
+/**
+ * @file image_loader.cpp
+ * @brief Implements the ImageLoader background decode pool.
+ */
+
+#include "image_loader.h"
+#include <algorithm>
+#include <iostream>
+#include <SDL_image.h>
+
+/**
+ * @brief Constructs an idle loader. Call start() to spawn workers.
+ */
+ImageLoader::ImageLoader() : decoding(0), stopping(false), assets(nullptr) {}
+
+/**
+ * @brief Stops the workers and frees any remaining surfaces.
+ */
+ImageLoader::~ImageLoader() {
+    stop();
+}
+
+/**
+ * @brief Starts the worker threads.
+ * @param workerCount Number of workers, or 0 to pick one from the CPU count.
+ */
+void ImageLoader::start(size_t workerCount) {
+    if (!workers.empty()) return;
+
+    if (workerCount == 0) {
+        // Leave one core for the render thread
+        unsigned int cores = std::thread::hardware_concurrency();
+        workerCount = std::clamp<size_t>(cores > 1 ? cores - 1 : 1, 1, 4);
+    }
+
+    stopping = false;
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ImageLoader::workerLoop, this);
+    }
+}
+
+/**
+ * @brief Stops the workers and frees every surface not yet taken.
+ */
+void ImageLoader::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& image : completed) {
+        if (image.surface) {
+            SDL_FreeSurface(image.surface);
+        }
+    }
+    completed.clear();
+    inFlight.clear();
+}
+
+/**
+ * @brief Queues an image for decoding.
+ * @param path Path of the image file.
+ * @param size Edge length of the square thumbnail to produce, or 0 to keep the original size.
+ * @param prefetch True if the image is not on screen yet.
+ * @return true if the request was newly queued.
+ */
+bool ImageLoader::request(const std::string& path, int size, bool prefetch) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || workers.empty()) {
+            return false;
+        }
+
+        auto inserted = inFlight.emplace(requestKey(path, size), prefetch);
+        if (!inserted.second) {
+            // Already known; a queued prefetch that is now on screen moves to the front
+            if (!prefetch && inserted.first->second) {
+                inserted.first->second = false;
+                auto it = std::find_if(queue.begin(), queue.end(), [&](const Request& queued) {
+                    return queued.size == size && queued.path == path;
+                });
+                if (it != queue.end()) {
+                    Request promoted = std::move(*it);
+                    promoted.prefetch = false;
+                    queue.erase(it);
+                    queue.push_front(std::move(promoted));
+                }
+            }
+            return false;
+        }
+
+        if (prefetch) {
+            queue.push_back({path, size, true});
+        } else {
+            queue.push_front({path, size, false});
+        }
+    }
+    wake.notify_one();
+    return true;
+}
+
+/**
+ * @brief Drops queued requests that are no longer wanted.
+ * @param keep Returns true for a path and size that should stay queued;
+ *             prefetch tells whether the request is still a prefetch.
+ * @return The number of requests dropped.
+ */
+size_t ImageLoader::cancelQueued(const std::function<bool(const std::string& path, int size, bool prefetch)>& keep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto kept = std::stable_partition(queue.begin(), queue.end(), [&](const Request& queued) {
+        return keep(queued.path, queued.size, queued.prefetch);
+    });
+
+    size_t cancelled = static_cast<size_t>(queue.end() - kept);
+    for (auto it = kept; it != queue.end(); ++it) {
+        inFlight.erase(requestKey(it->path, it->size));
+    }
+    queue.erase(kept, queue.end());
+    return cancelled;
+}
+
+/**
+ * @brief Takes the oldest decoded image if it fits the given byte budget.
+ * @param out Receives the image. The caller owns out.surface.
+ * @param maxBytes Largest surface size the caller is willing to accept.
+ * @return true if an image was taken.
+ */
+bool ImageLoader::popCompleted(DecodedImage& out, size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (completed.empty() || surfaceBytes(completed.front().surface) > maxBytes) {
+        return false;
+    }
+
+    out = std::move(completed.front());
+    completed.pop_front();
+    inFlight.erase(requestKey(out.path, out.size));
+    return true;
+}
+
+/**
+ * @brief Returns the number of images queued or being decoded.
+ */
+size_t ImageLoader::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size() + decoding;
+}
+
+/**
+ * @brief Returns the size in bytes of a surface's pixel data.
+ */
+size_t ImageLoader::surfaceBytes(const SDL_Surface* surface) {
+    return surface ? static_cast<size_t>(surface->pitch) * static_cast<size_t>(surface->h) : 0;
+}
+
+/**
+ * @brief Worker thread body: decodes queued paths until stopped.
+ */
+void ImageLoader::workerLoop() {
+    while (true) {
+        Request job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+            if (job.prefetch) {
+                inFlight[requestKey(job.path, job.size)] = false;  // No longer a queued prefetch
+            }
+            decoding++;
+        }
+
+        SDL_Surface* surface = decode(job.path, job.size, assets);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        decoding--;
+        if (stopping) {
+            if (surface) SDL_FreeSurface(surface);
+            return;
+        }
+        completed.push_back({job.path, job.size, surface});
+    }
+}
+
+/**
+ * @brief Builds the de-duplication key of a request.
+ */
+std::string ImageLoader::requestKey(const std::string& path, int size) {
+    return path + "@" + std::to_string(size);
+}
+
+/**
+ * @brief Loads an image file and converts it to the texture upload format.
+ *
+ * Built-in art ("asset:" paths) is copied out of the asset pack, which
+ * stores it already decoded; everything else is read from disk.
+ *
+ * @param path The file path of the image, or an AssetPack URI.
+ * @param size Edge length of the square thumbnail to produce, or 0 to keep the original size.
+ * @param pack Pack that AssetPack URIs are read from.
+ * @return An ARGB8888 surface, or nullptr if the file could not be loaded.
+ */
+SDL_Surface* ImageLoader::decode(const std::string& path, int size, const AssetPack* pack) {
+    SDL_Surface* surface = nullptr;
+    if (AssetPack::isAssetUri(path)) {
+        const std::string name = path.substr(std::char_traits<char>::length(AssetPack::URI_PREFIX));
+        surface = pack ? pack->loadImage(name) : nullptr;
+        if (!surface) {
+            std::cerr << "Image " << path << " is not in the asset pack" << std::endl;
+            return nullptr;
+        }
+    } else {
+        surface = IMG_Load(path.c_str());
+        if (!surface) {
+            std::cerr << "Failed to load image " << path << "! SDL_image Error: " << IMG_GetError() << std::endl;
+            return nullptr;
+        }
+    }
+
+    // Convert here so texture creation on the render thread is a plain copy
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        surface = converted;
+    }
+
+    if (surface && size > 0 && (surface->w != size || surface->h != size)) {
+        SDL_Surface* scaled = scaleToSquare(surface, size);
+        SDL_FreeSurface(surface);
+        surface = scaled;
+    }
+    return surface;
+}
+
+/**
+ * @brief Resamples an ARGB8888 surface to a square thumbnail with a box filter.
+ *
+ * Each destination pixel averages the block of source pixels it covers,
+ * which avoids the aliasing of nearest-neighbour SDL_BlitScaled when
+ * shrinking large covers. When enlarging, blocks are one pixel wide.
+ *
+ * @param source The surface to scale. Ownership stays with the caller.
+ * @param size Edge length of the result.
+ * @return A new ARGB8888 surface, or nullptr on allocation failure.
+ */
+SDL_Surface* ImageLoader::scaleToSquare(SDL_Surface* source, int size) {
+    SDL_Surface* result = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!result) {
+        return nullptr;
+    }
+
+    const Uint8* src = static_cast<const Uint8*>(source->pixels);
+    Uint8* dst = static_cast<Uint8*>(result->pixels);
+
+    for (int y = 0; y < size; ++y) {
+        int sy0 = y * source->h / size;
+        int sy1 = std::max(sy0 + 1, (y + 1) * source->h / size);
+        Uint32* out = reinterpret_cast<Uint32*>(dst + y * result->pitch);
+
+        for (int x = 0; x < size; ++x) {
+            int sx0 = x * source->w / size;
+            int sx1 = std::max(sx0 + 1, (x + 1) * source->w / size);
+            Uint32 a = 0, r = 0, g = 0, b = 0;
+
+            for (int sy = sy0; sy < sy1; ++sy) {
+                const Uint32* row = reinterpret_cast<const Uint32*>(src + sy * source->pitch);
+                for (int sx = sx0; sx < sx1; ++sx) {
+                    Uint32 p = row[sx];
+                    a += p >> 24;
+                    r += (p >> 16) & 0xFF;
+                    g += (p >> 8) & 0xFF;
+                    b += p & 0xFF;
+                }
+            }
+
+            Uint32 count = static_cast<Uint32>((sy1 - sy0) * (sx1 - sx0));
+            out[x] = ((a / count) << 24) | ((r / count) << 16) | ((g / count) << 8) | (b / count);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file image_loader.h
+ * @brief Declares the ImageLoader class, a worker pool that decodes images off the render thread.
+ *
+ * Workers turn image files into SDL_Surfaces in the background. Textures
+ * must still be created on the render thread, so the UI drains finished
+ * surfaces at a bounded rate each frame.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "asset_pack.h"
+
+/**
+ * @brief An image decoded by a worker, waiting for upload.
+ */
+struct DecodedImage {
+    std::string path;       ///< The path originally requested.
+    int size;               ///< Requested edge length, or 0 for the original size.
+    SDL_Surface* surface;   ///< ARGB8888 surface, or nullptr if decoding failed.
+};
+
+/**
+ * @class ImageLoader
+ * @brief Decodes image files on a pool of worker threads.
+ */
+class ImageLoader {
+public:
+    ImageLoader();
+    ~ImageLoader();
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param workerCount Number of workers, or 0 to pick one from the CPU count.
+     */
+    void start(size_t workerCount = 0);
+
+    /**
+     * @brief Lets workers resolve "asset:" paths from a pack. Call before start().
+     * @param pack The mapped pack, which must outlive the workers, or nullptr.
+     */
+    void setAssetPack(const AssetPack* pack) { assets = pack; }
+
+    /**
+     * @brief Stops the workers and frees every surface not yet taken.
+     */
+    void stop();
+
+    /**
+     * @brief Queues an image for decoding.
+     *
+     * Images needed on screen jump ahead of everything queued, newest first,
+     * since the latest visible rows are the ones still on screen. Prefetches
+     * are decoded in the order requested, after all visible images.
+     * Requests that are already queued, being decoded or waiting for upload
+     * are ignored, except that a queued prefetch is promoted when the image
+     * becomes visible.
+     *
+     * @param path Path of the image file.
+     * @param size Edge length of the square thumbnail to produce, or 0 to keep the original size.
+     * @param prefetch True if the image is not on screen yet.
+     * @return true if the request was newly queued.
+     */
+    bool request(const std::string& path, int size = 0, bool prefetch = false);
+
+    /**
+     * @brief Drops queued requests that are no longer wanted.
+     *
+     * Images already being decoded or waiting for upload are kept.
+     *
+     * @param keep Returns true for a path and size that should stay queued;
+     *             prefetch tells whether the request is still a prefetch.
+     * @return The number of requests dropped.
+     */
+    size_t cancelQueued(const std::function<bool(const std::string& path, int size, bool prefetch)>& keep);
+
+    /**
+     * @brief Takes the oldest decoded image if it fits the given byte budget.
+     *
+     * @param out Receives the image. The caller owns out.surface.
+     * @param maxBytes Largest surface size the caller is willing to accept.
+     * @return true if an image was taken.
+     */
+    bool popCompleted(DecodedImage& out, size_t maxBytes);
+
+    /**
+     * @brief Returns the number of images queued or being decoded.
+     */
+    size_t pendingCount() const;
+
+    /**
+     * @brief Returns the size in bytes of a surface's pixel data.
+     */
+    static size_t surfaceBytes(const SDL_Surface* surface);
+
+    /**
+     * @brief Loads an image file and converts it to ARGB8888 on the calling thread.
+     * @param path The file path of the image, or an AssetPack URI.
+     * @param size Edge length of the square thumbnail to produce, or 0 to keep the original size.
+     * @param pack Pack that AssetPack URIs are read from.
+     * @return The surface, or nullptr if the file could not be loaded. The caller owns it.
+     */
+    static SDL_Surface* decode(const std::string& path, int size, const AssetPack* pack = nullptr);
+
+    /**
+     * @brief Resamples an ARGB8888 surface to a square thumbnail with a box filter.
+     * @param source The surface to scale. Ownership stays with the caller.
+     * @param size Edge length of the result.
+     * @return A new ARGB8888 surface, or nullptr on allocation failure.
+     */
+    static SDL_Surface* scaleToSquare(SDL_Surface* source, int size);
+
+private:
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    struct Request {
+        std::string path;
+        int size;
+        bool prefetch;
+    };
+
+    std::deque<Request> queue;               ///< Requests waiting for a worker, visible ones first.
+    std::deque<DecodedImage> completed;      ///< Decoded surfaces waiting for upload.
+    /// Keys of queued, decoding or completed requests; true while queued as a prefetch.
+    std::unordered_map<std::string, bool> inFlight;
+    size_t decoding;
+    bool stopping;
+    const AssetPack* assets;
+
+    void workerLoop();
+    static std::string requestKey(const std::string& path, int size);
+};
@@ -4,12 +4,18 @@
  * Handles ROM file scanning, UI initialization, and game launching.
  */
 
+ #include <atomic>
  #include <iostream>
  #include <filesystem>
+ #include <thread>
  #include <vector>
+ #include <cstdio>
  #include <cstdlib>
  #include "sdl_ui.h"
  #include "emulator_launcher.h"
+ #include "startup_graph.h"
+ #include "chr_mosaic.h"
+ #include "process_supervisor.h"
 
  
  namespace fs = std::filesystem;
@@ -37,6 +43,98 @@
      return roms;
  }
  
+ /**
+  * Builds tile mosaic covers from the ROMs' own graphics, reusing cached ones
+  * @param gamesDir Path to the directory containing ROM files
+  * @param roms ROM filenames as returned by scanForRoms()
+  * @return One record per ROM with the mosaic's path and preview set,
+  *         or an empty image path if the ROM has no usable tiles
+  */
+ std::vector<GameMetadata> generateFallbackArt(const fs::path& gamesDir, const std::vector<std::string>& roms) {
+     std::vector<GameMetadata> art(roms.size());
+     for (size_t i = 0; i < roms.size(); ++i) {
+         std::string path = "images/rom_art/" + fs::path(roms[i]).stem().string() + ".png";
+         if (ChrMosaic::generate((gamesDir / roms[i]).string(), path, art[i].previewHash, art[i].dominantColor)) {
+             art[i].imagePath = path;
+         }
+     }
+     return art;
+ }
+
+ /**
+  * Gives games without IGDB cover art their tile mosaic instead of the shared placeholder
+  * @param library Metadata in ROM order
+  * @param art Mosaics in the same order, from generateFallbackArt()
+  */
+ void applyFallbackArt(std::vector<GameMetadata>& library, std::vector<GameMetadata>& art) {
+     for (size_t i = 0; i < library.size() && i < art.size(); ++i) {
+         GameMetadata& game = library[i];
+         bool placeholder = game.imagePath.empty() || game.imagePath == AssetPack::PLACEHOLDER_URI;
+         if (placeholder && !art[i].imagePath.empty()) {
+             game.imagePath = std::move(art[i].imagePath);
+             game.previewHash = std::move(art[i].previewHash);
+             game.dominantColor = art[i].dominantColor;
+         }
+     }
+ }
+
+ /**
+  * Reads a size in megabytes from an environment variable
+  * @param name Name of the environment variable
+  * @param fallbackBytes Value returned when the variable is unset or invalid
+  * @return The configured size in bytes
+  */
+ size_t readEnvMegabytes(const char* name, size_t fallbackBytes) {
+     const char* value = std::getenv(name);
+     if (!value) {
+         return fallbackBytes;
+     }
+     char* end = nullptr;
+     unsigned long megabytes = std::strtoul(value, &end, 10);
+     if (end == value || megabytes == 0) {
+         std::cerr << "Ignoring invalid " << name << "=" << value << std::endl;
+         return fallbackBytes;
+     }
+     return static_cast<size_t>(megabytes) * 1024 * 1024;
+ }
+
+ /**
+  * Reads a hold-to-repeat curve from an environment variable
+  * formatted as "delay_ms,interval_ms,min_interval_ms,ramp_ms"
+  * @param name Name of the environment variable
+  * @param fallback Curve returned when the variable is unset or invalid
+  * @return The configured curve
+  */
+ RepeatCurve readEnvRepeatCurve(const char* name, const RepeatCurve& fallback) {
+     const char* value = std::getenv(name);
+     if (!value) {
+         return fallback;
+     }
+     float delay, interval, minInterval, ramp;
+     if (std::sscanf(value, "%f,%f,%f,%f", &delay, &interval, &minInterval, &ramp) != 4 ||
+         delay < 0.0f || interval <= 0.0f || minInterval <= 0.0f || minInterval > interval || ramp < 0.0f) {
+         std::cerr << "Ignoring invalid " << name << "=" << value << std::endl;
+         return fallback;
+     }
+     RepeatCurve curve = fallback;
+     curve.initialDelay = delay / 1000.0f;
+     curve.startInterval = interval / 1000.0f;
+     curve.minInterval = minInterval / 1000.0f;
+     curve.rampTime = ramp / 1000.0f;
+     return curve;
+ }
+
+ /**
+  * Prints the counters of a texture cache
+  * @param label Name of the cache
+  * @param stats Counters to print
+  */
+ void printCacheStats(const char* label, const TextureCacheStats& stats) {
+     std::cout << label << " cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+               << stats.evictions << " evictions, " << stats.entries << " textures, "
+               << stats.residentBytes / 1024 << " KiB of " << stats.budgetBytes / 1024 << " KiB" << std::endl;
+ }
+
  /**
   * Main program entry point
   * Initializes the UI and emulator, scans for ROMs,
@@ -45,30 +143,18 @@
  int main() {
      // Initialize the SDL-based user interface system
      SDLUI ui;
-     if (!ui.init()) {
-         std::cerr << "Failed to initialize UI" << std::endl;
-         return 1;
-     }
- 
-     // Initialize IGDB client with hardcoded credentials
-     // Note: IGDB is optional, the app will work without it
-     try {
-         if (!ui.initIGDB("sa09yuxskyo4guu5d1pgntjoc3ucw0", "wu99x3crhhckdbqb41hw5u7q4sjbao")) {
-             std::cerr << "Warning: Failed to initialize IGDB client. Using basic metadata." << std::endl;
+     SDLUI::RenderBackend backend = SDLUI::RenderBackend::Auto;
+     if (const char* renderer = std::getenv("RETRO_RENDERER")) {
+         std::string choice = renderer;
+         if (choice == "software") {
+             backend = SDLUI::RenderBackend::Software;
+         } else if (choice == "gpu") {
+             backend = SDLUI::RenderBackend::Gpu;
+         } else {
+             std::cerr << "Ignoring invalid RETRO_RENDERER=" << choice << std::endl;
          }
-     } catch (const std::exception& e) {
-         std::cerr << "Warning: IGDB initialization error: " << e.what() << std::endl;
-         std::cerr << "Continuing with basic metadata..." << std::endl;
-     }
- 
-     // Set up the emulator launcher with nestopia emulator
-     EmulatorLauncher emulator;
-     if (!emulator.init("nestopia")) {  // Assuming nestopia is in PATH
-         ui.showError("Failed to initialize emulator: " + emulator.getLastError());
-         return 1;
      }
 
- 
      // Determine the games directory path relative to the executable
      // Structure: project_root/
      //           ├── build/     (executable location)
@@ -76,18 +162,165 @@
      fs::path exePath = fs::current_path();
      fs::path projectRoot = exePath.parent_path(); // Go up from build directory
      fs::path gamesDir = projectRoot / "games";
-     auto roms = scanForRoms(gamesDir);
- 
+
+     // Startup runs as a dependency graph: assets, window creation, emulator
+     // setup and the ROM scan overlap. SDL video stays on this thread. The
+     // menu comes up with titles taken from the filenames; nothing on the
+     // way to the first frame waits for the network.
+     using Affinity = StartupGraph::Affinity;
+     StartupGraph startup;
+     EmulatorLauncher emulator;
+     std::vector<std::string> roms;
+     std::vector<GameMetadata> library;
+     std::vector<GameMetadata> fallbackArt;
+
+     auto assetsTask = startup.add("assets", [&]() { return ui.initAssets(); });
+     auto windowTask = startup.add("window", [&]() { return ui.initWindow(false, backend); }, {}, Affinity::Main);
+     auto uiTask = startup.add("ui", [&]() {
+         if (!ui.finishInit()) {
+             return false;
+         }
+
+         // Texture cache budgets can be lowered on small devices
+         ui.setTextureCacheBudgets(readEnvMegabytes("RETRO_COVER_CACHE_MB", SDLUI::DEFAULT_COVER_CACHE_BYTES),
+                                   readEnvMegabytes("RETRO_TEXT_CACHE_MB", SDLUI::DEFAULT_TEXT_CACHE_BYTES),
+                                   readEnvMegabytes("RETRO_ROW_CACHE_MB", SDLUI::DEFAULT_ROW_CACHE_BYTES));
+
+         // A larger UI scale suits TVs and cabinets viewed from across the room
+         if (const char* scale = std::getenv("RETRO_UI_SCALE")) {
+             float value = std::strtof(scale, nullptr);
+             if (value > 0.0f) {
+                 ui.setUiScale(value);
+             }
+         }
+
+         // Hold-to-scroll acceleration, separately for the keyboard and game controllers
+         ui.setRepeatCurves(readEnvRepeatCurve("RETRO_KEY_REPEAT", RepeatCurve()),
+                            readEnvRepeatCurve("RETRO_PAD_REPEAT", RepeatCurve()));
+         return true;
+     }, {assetsTask, windowTask}, Affinity::Main);
+
+     // Set up the emulator launcher, nestopia from PATH unless configured otherwise
+     auto emulatorTask = startup.add("emulator", [&]() {
+         const char* path = std::getenv("RETRO_EMULATOR");
+         if (!emulator.init(path ? path : "nestopia")) {
+             return false;
+         }
+
+         // Emulators that speak the control protocol can be started ahead of time
+         if (const char* pool = std::getenv("RETRO_WARM_POOL")) {
+             emulator.enableWarmPool(std::strtoul(pool, nullptr, 10));
+             emulator.refillPool();
+         }
+         return true;
+     });
+
+     auto scanTask = startup.add("rom-scan", [&]() {
+         roms = scanForRoms(gamesDir);
+         return !roms.empty();
+     });
+
+     // Filename titles and placeholder covers until the metadata arrives
+     auto libraryTask = startup.add("library", [&]() {
+         std::vector<GameMetadata> basic;
+         basic.reserve(roms.size());
+         for (const std::string& rom : roms) {
+             basic.push_back(SDLUI::basicMetadata(rom));
+         }
+         ui.setGameLibrary(std::move(basic));
+         return true;
+     }, {scanTask, uiTask}, Affinity::Main);
+
+     startup.run();
+     startup.printReport(std::cout);
+
+     if (!startup.succeeded(uiTask)) {
+         std::cerr << "Failed to initialize UI" << std::endl;
+         return 1;
+     }
+     if (!startup.succeeded(emulatorTask)) {
+         ui.showError("Failed to initialize emulator: " + emulator.getLastError());
+         return 1;
+     }
+
      // Check if any ROM files were found
-     if (roms.empty()) {
+     if (!startup.succeeded(scanTask)) {
          ui.showError("No ROM files found in games directory. Please add some .nes files.");
          return 1;
      }
- 
+     if (!startup.succeeded(libraryTask)) {
+         ui.showError("Failed to load the game library");
+         return 1;
+     }
+
+     // IGDB metadata and ROM-derived covers are resolved by a second graph
+     // while the menu is already up, and replace the filename library on the
+     // next frame after both are done. Its tasks may use SDL_image, which
+     // initAssets() has initialized by now.
+     StartupGraph enrich;
+     std::atomic<bool> quitting(false);
+
+     // Initialize IGDB client with hardcoded credentials
+     // Note: IGDB is optional, the app will work without it
+     auto authTask = enrich.add("igdb-auth", [&]() {
+         try {
+             if (!ui.initIGDB("sa09yuxskyo4guu5d1pgntjoc3ucw0", "wu99x3crhhckdbqb41hw5u7q4sjbao")) {
+                 std::cerr << "Warning: Failed to initialize IGDB client. Using basic metadata." << std::endl;
+             }
+         } catch (const std::exception& e) {
+             std::cerr << "Warning: IGDB initialization error: " << e.what() << std::endl;
+             std::cerr << "Continuing with basic metadata..." << std::endl;
+         }
+         return true;
+     });
+
+     // Downloaded covers are loaded to compute their previews
+     auto metadataTask = enrich.add("metadata", [&]() {
+         library = ui.fetchGameMetadata(roms, &quitting);
+         return !quitting;
+     }, {authTask});
+
+     // Games IGDB does not know get covers drawn from their own CHR-ROM,
+     // built while the metadata is still downloading
+     auto artTask = enrich.add("rom-art", [&]() {
+         fallbackArt = generateFallbackArt(gamesDir, roms);
+         return true;
+     });
+
+     enrich.add("apply", [&]() {
+         applyFallbackArt(library, fallbackArt);
+         ui.postGameLibrary(std::move(library));
+         return true;
+     }, {metadataTask, artTask});
+
+     std::thread enricher([&enrich]() {
+         enrich.run();
+         enrich.printReport(std::cout, "Library metadata");
+     });
+
+     // Reaps each emulator and wakes the UI the moment it exits
+     ProcessSupervisor supervisor;
+     supervisor.start([&ui](const GameSession&) { ui.notifyGameExited(); });
+
+     // Keep the window alive while a slow emulator starts up
+     emulator.setWaitCallback([&ui]() { ui.pumpEvents(); });
+
+     // Get the highlighted game's launch ready while the user looks at it
+     ui.setDwellCallback([&](int game) {
+         if (game < 0) {
+             emulator.cancelPreparation();
+         } else {
+             emulator.prepare(gamesDir / roms[game]);
+         }
+     });
+
      // Main program loop - display game list and handle selection
      while (true) {
+         // Replace warm emulators used by the last launch while nothing is running
+         emulator.refillPool();
+
          // Display game list and get selection
-         int selection = ui.displayGameList(roms);
+         int selection = ui.displayGameList();
          
          // Check for exit condition (-1 returned when user chooses to exit)
          if (selection == -1) {
@@ -96,12 +329,64 @@
  
          // Attempt to launch the selected game using the emulator
          fs::path romPath = gamesDir / roms[selection];
+         int exitStatus = 0;
+         std::chrono::system_clock::time_point stopped;
          if (!emulator.launchGame(romPath)) {
+             // An emulator that started and failed still counts as a session
+             if (emulator.takeExit(exitStatus, stopped)) {
+                 supervisor.record(roms[selection], emulator.getLastLaunchTime(), stopped, exitStatus);
+             }
              ui.showError("Failed to launch game: " + emulator.getLastError());
              continue;
          }
+         std::cout << "Started emulator (" << (emulator.wasLastLaunchWarm() ? "warm" : "cold")
+                   << (emulator.wasLastLaunchPrepared() ? ", prepared" : "") << ") in "
+                   << emulator.getLastLaunchMillis() << " ms";
+         if (emulator.getLastFirstFrameMillis() >= 0.0) {
+             std::cout << ", first frame after " << emulator.getLastFirstFrameMillis() << " ms";
+         }
+         std::cout << std::endl;
+
+         // Stay out of the way until the game exits, then show the menu again
+         if (supervisor.watch(emulator.detachChild(), roms[selection], emulator.getLastLaunchTime())) {
+             ui.waitForGame(ui.getCatalog().title(static_cast<GameId>(selection)));
+             const HibernationStats& idle = ui.getLastHibernation();
+             std::cout << "While playing: launcher used " << idle.cpuMillis << " ms CPU in " << idle.seconds
+                       << " s, RSS " << idle.residentDuring / (1024 * 1024) << " MiB (was "
+                       << idle.residentBefore / (1024 * 1024) << " MiB), menu frame kept in "
+                       << idle.snapshotBytes / 1024 << " KiB; menu back in " << idle.resumeMillis << " ms" << std::endl;
+         } else if (emulator.takeExit(exitStatus, stopped)) {
+             // The game was over before the supervisor could watch it
+             supervisor.record(roms[selection], emulator.getLastLaunchTime(), stopped, exitStatus);
+         }
 
      }
+
+     // Abandon metadata still downloading; the launcher is closing
+     quitting = true;
+     enricher.join();
+
+     supervisor.stop();
+     double playSeconds = 0.0;
+     std::vector<GameSession> sessions = supervisor.getSessions();
+     for (const GameSession& session : sessions) {
+         playSeconds += session.seconds();
+     }
+     std::cout << "Played " << sessions.size() << " sessions, " << playSeconds / 60.0 << " minutes in total" << std::endl;
+
+     printCacheStats("Cover atlas", ui.getCoverCacheStats());
+     printCacheStats("Text texture", ui.getTextCacheStats());
+     printCacheStats("List row", ui.getRowCacheStats());
+     RenderStats frameStats = ui.getLastFrameRenderStats();
+     std::cout << "Last frame: " << frameStats.drawCalls << " draw calls, " << frameStats.textureSwitches
+               << " texture switches, " << frameStats.batchedQuads << " batched covers" << std::endl;
+     PrefetchStats prefetch = ui.getPrefetchStats();
+     std::cout << "Cover prefetch: " << prefetch.readyOnArrival << " of " << prefetch.arrivals
+               << " covers ready when scrolled into view (" << prefetch.hitRate() * 100.0 << "%), "
+               << prefetch.requested << " queued ahead, " << prefetch.cancelled << " cancelled" << std::endl;
+     const FrameProfiler& profiler = ui.getFrameProfiler();
+     std::cout << "Frame time p50/p95/p99: " << profiler.framePercentile(0.50) << " / "
+               << profiler.framePercentile(0.95) << " / " << profiler.framePercentile(0.99) << " ms" << std::endl;
  
      ui.cleanup();
      return 0;
@@ -0,0 +1,282 @@
+/**
+ * @file process_supervisor.cpp
+ * @brief Implements the pidfd watcher thread and session accounting of ProcessSupervisor.
+ */
+
+#include "process_supervisor.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Opens a pidfd for a process, or returns -1 where the kernel has none.
+ */
+int openPidfd(pid_t pid) {
+#ifdef SYS_pidfd_open
+    int fd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (fd >= 0) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);  // Emulators launched later must not inherit it
+    }
+    return fd;
+#else
+    (void)pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Ends a session with a waitpid() status.
+ */
+void closeSession(GameSession& session, std::chrono::system_clock::time_point stopped, int status) {
+    session.stopped = stopped;
+    session.running = false;
+    if (WIFEXITED(status)) {
+        session.exitCode = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        session.signal = WTERMSIG(status);
+    }
+}
+
+/**
+ * @brief Logs how a session ended.
+ */
+void printSession(const GameSession& session) {
+    std::cout << "Session ended: " << session.rom << " ran for " << session.seconds() << " s, ";
+    if (session.signal != 0) {
+        std::cout << "killed by signal " << session.signal << std::endl;
+    } else {
+        std::cout << "exit status " << session.exitCode << std::endl;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Returns the play time in seconds, so far if still running.
+ */
+double GameSession::seconds() const {
+    auto end = running ? std::chrono::system_clock::now() : stopped;
+    return std::chrono::duration<double>(end - started).count();
+}
+
+/**
+ * @brief Constructs an idle supervisor. Call start() to spawn the watcher.
+ */
+ProcessSupervisor::ProcessSupervisor() : wakePipe{-1, -1}, stopping(false) {}
+
+/**
+ * @brief Stops the watcher.
+ */
+ProcessSupervisor::~ProcessSupervisor() {
+    stop();
+}
+
+/**
+ * @brief Starts the watcher thread.
+ * @param onExit Called for every process that exits.
+ * @return false if the wake-up pipe could not be created.
+ */
+bool ProcessSupervisor::start(ExitCallback onExit) {
+    if (watcher.joinable()) return true;
+
+    if (pipe(wakePipe) != 0) {
+        std::cerr << "Failed to create supervisor pipe: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    for (int fd : wakePipe) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+    }
+
+    this->onExit = std::move(onExit);
+    stopping = false;
+    watcher = std::thread(&ProcessSupervisor::watcherLoop, this);
+    return true;
+}
+
+/**
+ * @brief Stops the watcher. Processes still running are left alone and no longer tracked.
+ */
+void ProcessSupervisor::stop() {
+    if (!watcher.joinable()) return;
+
+    stopping = true;
+    wake();
+    watcher.join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Watched& entry : watched) {
+        if (entry.pidfd >= 0) close(entry.pidfd);
+    }
+    watched.clear();
+    for (int& fd : wakePipe) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * @brief Starts a session for a child process of this launcher.
+ * @param pid The child, which nothing else may wait for.
+ * @param rom ROM filename recorded with the session.
+ * @param started When the process was launched.
+ * @return false if the supervisor is not running or pid is invalid.
+ */
+bool ProcessSupervisor::watch(pid_t pid, const std::string& rom, std::chrono::system_clock::time_point started) {
+    if (!watcher.joinable() || pid <= 0) {
+        return false;
+    }
+
+    int pidfd = openPidfd(pid);
+    if (pidfd < 0 && errno != ENOSYS) {
+        std::cerr << "pidfd_open failed for " << pid << ": " << std::strerror(errno) << std::endl;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        GameSession session;
+        session.rom = rom;
+        session.pid = pid;
+        session.started = started;
+        sessions.push_back(std::move(session));
+        watched.push_back({pid, pidfd, sessions.size() - 1});
+    }
+    wake();
+    return true;
+}
+
+/**
+ * @brief Records a session whose process was reaped before it could be watched.
+ * @param rom ROM filename recorded with the session.
+ * @param started When the process was launched.
+ * @param stopped When it was reaped.
+ * @param status Its waitpid() status.
+ */
+void ProcessSupervisor::record(const std::string& rom, std::chrono::system_clock::time_point started,
+                               std::chrono::system_clock::time_point stopped, int status) {
+    GameSession session;
+    session.rom = rom;
+    session.started = started;
+    closeSession(session, stopped, status);
+    printSession(session);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    sessions.push_back(std::move(session));
+}
+
+/**
+ * @brief Returns true while any watched process is running.
+ */
+bool ProcessSupervisor::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !watched.empty();
+}
+
+/**
+ * @brief Returns every session so far, finished and running, in launch order.
+ */
+std::vector<GameSession> ProcessSupervisor::getSessions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sessions;
+}
+
+/**
+ * @brief Makes the watcher leave poll() and rebuild its descriptor set.
+ */
+void ProcessSupervisor::wake() {
+    char byte = 1;
+    if (write(wakePipe[1], &byte, 1) < 0 && errno != EAGAIN) {
+        std::cerr << "Failed to wake the supervisor: " << std::strerror(errno) << std::endl;
+    }
+}
+
+/**
+ * @brief Blocks until a watched process exits or the set changes, then reaps what has exited.
+ */
+void ProcessSupervisor::watcherLoop() {
+    std::vector<pollfd> fds;
+    std::vector<Watched> current;
+    while (!stopping) {
+        int timeout = -1;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = watched;
+        }
+        fds.assign(1, {wakePipe[0], POLLIN, 0});
+        for (const Watched& entry : current) {
+            if (entry.pidfd >= 0) {
+                fds.push_back({entry.pidfd, POLLIN, 0});
+            } else {
+                timeout = FALLBACK_POLL_MS;
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+            std::cerr << "Supervisor poll failed: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+        }
+
+        // A readable pidfd means that process exited; without one, ask waitpid()
+        size_t next = 1;
+        for (const Watched& entry : current) {
+            bool signalled = entry.pidfd < 0;
+            if (entry.pidfd >= 0) {
+                signalled = (fds[next++].revents & (POLLIN | POLLHUP)) != 0;
+            }
+            if (signalled && !stopping) {
+                reap(entry);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reaps a process that may have exited and closes its session.
+ * @return true if it had exited.
+ */
+bool ProcessSupervisor::reap(const Watched& entry) {
+    int status = 0;
+    pid_t result = waitpid(entry.pid, &status, WNOHANG);
+    if (result == 0) {
+        return false;
+    }
+
+    GameSession finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        GameSession& session = sessions[entry.session];
+        if (result == entry.pid) {
+            closeSession(session, std::chrono::system_clock::now(), status);
+        } else {
+            session.stopped = std::chrono::system_clock::now();
+            session.running = false;
+        }
+        finished = session;
+
+        if (entry.pidfd >= 0) close(entry.pidfd);
+        for (auto it = watched.begin(); it != watched.end(); ++it) {
+            if (it->pid == entry.pid) {
+                watched.erase(it);
+                break;
+            }
+        }
+    }
+
+    printSession(finished);
+    if (onExit) {
+        onExit(finished);
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file process_supervisor.h
+ * @brief Declares ProcessSupervisor, which waits for emulator processes to exit and reaps them.
+ *
+ * Each launched emulator is watched through a pidfd, a file descriptor
+ * that becomes readable when the process exits. One watcher thread blocks
+ * in poll() on all of them, so an exit is noticed the moment it happens
+ * without any timer. The watcher reaps the child, closes the session
+ * (start and stop time, exit status) and calls back, which lets the UI
+ * wake its event loop and return to the menu.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @brief One run of a game, from launch to exit.
+ */
+struct GameSession {
+    std::string rom;                                 ///< ROM filename.
+    pid_t pid = -1;                                  ///< Emulator process.
+    std::chrono::system_clock::time_point started;   ///< When the emulator was launched.
+    std::chrono::system_clock::time_point stopped;   ///< When it exited, if it has.
+    bool running = true;
+    int exitCode = -1;                               ///< Exit status, or -1 if killed by a signal.
+    int signal = 0;                                  ///< Signal that ended it, or 0.
+
+    /**
+     * @brief Returns the play time in seconds, so far if still running.
+     */
+    double seconds() const;
+};
+
+/**
+ * @class ProcessSupervisor
+ * @brief Watches child processes on a background thread and reports their exit.
+ */
+class ProcessSupervisor {
+public:
+    /// Called on the watcher thread after a session has ended and its process was reaped
+    using ExitCallback = std::function<void(const GameSession&)>;
+
+    ProcessSupervisor();
+    ~ProcessSupervisor();
+
+    ProcessSupervisor(const ProcessSupervisor&) = delete;
+    ProcessSupervisor& operator=(const ProcessSupervisor&) = delete;
+
+    /**
+     * @brief Starts the watcher thread.
+     * @param onExit Called for every process that exits.
+     * @return false if the wake-up pipe could not be created.
+     */
+    bool start(ExitCallback onExit);
+
+    /**
+     * @brief Stops the watcher. Processes still running are left alone and no longer tracked.
+     */
+    void stop();
+
+    /**
+     * @brief Starts a session for a child process of this launcher.
+     * @param pid The child, which nothing else may wait for.
+     * @param rom ROM filename recorded with the session.
+     * @param started When the process was launched.
+     * @return false if the supervisor is not running or pid is invalid.
+     */
+    bool watch(pid_t pid, const std::string& rom,
+               std::chrono::system_clock::time_point started = std::chrono::system_clock::now());
+
+    /**
+     * @brief Records a session whose process was reaped before it could be watched.
+     *
+     * For an emulator that exited during its launch. No callback is made:
+     * nothing is waiting for the exit.
+     *
+     * @param rom ROM filename recorded with the session.
+     * @param started When the process was launched.
+     * @param stopped When it was reaped.
+     * @param status Its waitpid() status.
+     */
+    void record(const std::string& rom, std::chrono::system_clock::time_point started,
+                std::chrono::system_clock::time_point stopped, int status);
+
+    /**
+     * @brief Returns true while any watched process is running.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Returns every session so far, finished and running, in launch order.
+     */
+    std::vector<GameSession> getSessions() const;
+
+private:
+    /// Kernels older than 5.3 have no pidfd; children are then checked this often
+    static const int FALLBACK_POLL_MS = 250;
+
+    struct Watched {
+        pid_t pid;
+        int pidfd;         ///< -1 if pidfd_open() is unavailable.
+        size_t session;    ///< Index into sessions.
+    };
+
+    std::thread watcher;
+    mutable std::mutex mutex;
+    std::vector<GameSession> sessions;
+    std::vector<Watched> watched;
+    ExitCallback onExit;
+    int wakePipe[2];       ///< Written to make the watcher rebuild its poll set or stop.
+    std::atomic<bool> stopping;
+
+    void watcherLoop();
+    void wake();
+    bool reap(const Watched& entry);
+};
@@ -0,0 +1,15 @@
+/**
+ * @file render_stats.h
+ * @brief Declares the per-frame draw submission counters reported by the UI.
+ */
+
+#pragma once
+
+/**
+ * @brief Counts the draw submissions made while rendering one frame.
+ */
+struct RenderStats {
+    int drawCalls = 0;        ///< SDL_RenderCopy/FillRect/Geometry submissions.
+    int textureSwitches = 0;  ///< Draws that used a different texture than the previous draw.
+    int batchedQuads = 0;     ///< Cover quads drawn through the atlas batch.
+};
@@ -0,0 +1,204 @@
+/**
+ * @file scroll_animator.cpp
+ * @brief Implements the time-based ScrollAnimator and HoldRepeater.
+ */
+
+#include "scroll_animator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float MIN_FLING_SPEED = 5.0f;  ///< Pixels per second below which a fling stops.
+const float SETTLE_DISTANCE = 0.25f; ///< Pixels from the target at which easing snaps.
+
+} // namespace
+
+/**
+ * @brief Constructs a resting animator at offset 0.
+ */
+ScrollAnimator::ScrollAnimator()
+    : position(0.0f), target(0.0f), velocity(0.0f), minPosition(0.0f), maxPosition(0.0f),
+      followRate(16.0f), friction(4.0f), following(false) {}
+
+/**
+ * @brief Sets the valid range of the scroll offset and clamps to it.
+ */
+void ScrollAnimator::setBounds(float minPosition, float maxPosition) {
+    this->minPosition = minPosition;
+    this->maxPosition = std::max(minPosition, maxPosition);
+    position = clamp(position);
+    target = clamp(target);
+}
+
+/**
+ * @brief Eases towards a target offset, cancelling any fling.
+ */
+void ScrollAnimator::scrollTo(float target) {
+    this->target = clamp(target);
+    velocity = 0.0f;
+    following = this->target != position;
+}
+
+/**
+ * @brief Moves to an offset immediately and stops all motion.
+ */
+void ScrollAnimator::jumpTo(float position) {
+    this->position = clamp(position);
+    target = this->position;
+    velocity = 0.0f;
+    following = false;
+}
+
+/**
+ * @brief Adds kinetic velocity in pixels per second.
+ */
+void ScrollAnimator::fling(float velocity) {
+    following = false;
+    this->velocity += velocity;
+}
+
+/**
+ * @brief Moves the offset directly and stops all motion.
+ */
+void ScrollAnimator::dragBy(float delta) {
+    jumpTo(position + delta);
+}
+
+/**
+ * @brief Advances the animation in closed form.
+ *
+ * Easing uses x += (target - x) * (1 - e^(-k dt)) and coasting integrates
+ * v e^(-f t) exactly, so the result does not depend on how dt is split
+ * into frames.
+ *
+ * @param dt Seconds since the previous update.
+ */
+void ScrollAnimator::update(float dt) {
+    if (dt <= 0.0f) return;
+
+    if (following) {
+        position += (target - position) * (1.0f - std::exp(-followRate * dt));
+        if (std::fabs(target - position) < SETTLE_DISTANCE) {
+            position = target;
+            following = false;
+        }
+        return;
+    }
+
+    if (velocity != 0.0f) {
+        float decay = std::exp(-friction * dt);
+        position += velocity * (1.0f - decay) / friction;
+        velocity *= decay;
+
+        float clamped = clamp(position);
+        if (clamped != position || std::fabs(velocity) < MIN_FLING_SPEED) {
+            velocity = 0.0f;  // Hit an edge or ran out of speed
+        }
+        position = clamped;
+        target = position;
+    }
+}
+
+/**
+ * @brief Returns the offset the current motion will settle at.
+ */
+float ScrollAnimator::getRestingPosition() const {
+    if (following) return target;
+    return clamp(position + velocity / friction);
+}
+
+/**
+ * @brief Returns true while easing or coasting.
+ */
+bool ScrollAnimator::isMoving() const {
+    return following || velocity != 0.0f;
+}
+
+/**
+ * @brief Sets the easing rate and the fling friction, both in 1/s.
+ */
+void ScrollAnimator::setRates(float followRate, float friction) {
+    this->followRate = std::max(0.1f, followRate);
+    this->friction = std::max(0.1f, friction);
+}
+
+/**
+ * @brief Clamps a value to the scroll bounds.
+ */
+float ScrollAnimator::clamp(float value) const {
+    return std::clamp(value, minPosition, maxPosition);
+}
+
+/**
+ * @brief Constructs a released repeater with the given curve.
+ */
+HoldRepeater::HoldRepeater(const RepeatCurve& curve)
+    : curve(curve), held(false), heldTime(0.0f), untilNext(0.0f) {}
+
+/**
+ * @brief Replaces the repeat curve.
+ */
+void HoldRepeater::setCurve(const RepeatCurve& curve) {
+    this->curve = curve;
+}
+
+/**
+ * @brief Starts holding. The caller applies the first step itself.
+ */
+void HoldRepeater::press() {
+    held = true;
+    heldTime = 0.0f;
+    untilNext = curve.initialDelay;
+}
+
+/**
+ * @brief Stops holding.
+ */
+void HoldRepeater::release() {
+    held = false;
+}
+
+/**
+ * @brief Advances the hold timer and returns the steps that became due.
+ *
+ * Repeats are scheduled on the hold timeline rather than per frame, so a
+ * long frame produces every repeat that fell inside it.
+ *
+ * @param dt Seconds since the previous update.
+ * @return Number of steps to apply.
+ */
+int HoldRepeater::update(float dt) {
+    if (!held || dt <= 0.0f) return 0;
+
+    int steps = 0;
+    float frameEnd = heldTime + dt;
+    while (untilNext <= dt) {
+        float repeatTime = frameEnd - dt + untilNext;
+        steps += stepsAt(repeatTime);
+        dt -= untilNext;
+        untilNext = intervalAt(repeatTime);
+    }
+    untilNext -= dt;
+    heldTime = frameEnd;
+    return steps;
+}
+
+/**
+ * @brief Returns the interval between repeats at a point in the hold.
+ */
+float HoldRepeater::intervalAt(float time) const {
+    float ramp = curve.rampTime > 0.0f ? (time - curve.initialDelay) / curve.rampTime : 1.0f;
+    ramp = std::clamp(ramp, 0.0f, 1.0f);
+    return std::max(0.001f, curve.startInterval + (curve.minInterval - curve.startInterval) * ramp);
+}
+
+/**
+ * @brief Returns how many steps one repeat moves at a point in the hold.
+ */
+int HoldRepeater::stepsAt(float time) const {
+    float fullSpeedTime = time - curve.initialDelay - curve.rampTime;
+    if (fullSpeedTime <= 0.0f) return 1;
+    int steps = 1 + static_cast<int>(fullSpeedTime * curve.stepGrowth);
+    return std::min(steps, std::max(1, curve.maxStepsPerRepeat));
+}
@@ -0,0 +1,139 @@
+/**
+ * @file scroll_animator.h
+ * @brief Declares ScrollAnimator and HoldRepeater, the time-based scrolling helpers used by SDLUI.
+ *
+ * Every motion is integrated in closed form from the elapsed time, so the
+ * scroll position after one 50 ms frame equals the position after three
+ * ~16 ms frames and long frames do not change the feel.
+ */
+
+#pragma once
+
+/**
+ * @class ScrollAnimator
+ * @brief A scroll offset that eases towards a target or coasts with friction.
+ */
+class ScrollAnimator {
+public:
+    ScrollAnimator();
+
+    /**
+     * @brief Sets the valid range of the scroll offset and clamps to it.
+     */
+    void setBounds(float minPosition, float maxPosition);
+
+    /**
+     * @brief Eases towards a target offset, cancelling any fling.
+     */
+    void scrollTo(float target);
+
+    /**
+     * @brief Moves to an offset immediately and stops all motion.
+     */
+    void jumpTo(float position);
+
+    /**
+     * @brief Adds kinetic velocity in pixels per second. Friction slows it down.
+     */
+    void fling(float velocity);
+
+    /**
+     * @brief Moves the offset directly (finger drag) and stops all motion.
+     */
+    void dragBy(float delta);
+
+    /**
+     * @brief Advances the animation.
+     * @param dt Seconds since the previous update.
+     */
+    void update(float dt);
+
+    /**
+     * @brief Returns the current offset.
+     */
+    float getPosition() const { return position; }
+
+    /**
+     * @brief Returns the offset the current motion will settle at.
+     */
+    float getRestingPosition() const;
+
+    /**
+     * @brief Returns true while easing or coasting.
+     */
+    bool isMoving() const;
+
+    /**
+     * @brief Sets how fast scrollTo() converges (1/s) and how fast flings decay (1/s).
+     */
+    void setRates(float followRate, float friction);
+
+private:
+    float position;
+    float target;
+    float velocity;
+    float minPosition;
+    float maxPosition;
+    float followRate;
+    float friction;
+    bool following;
+
+    float clamp(float value) const;
+};
+
+/**
+ * @brief Shape of the accelerating repeat used while a direction is held.
+ */
+struct RepeatCurve {
+    float initialDelay = 0.30f;   ///< Seconds before the first repeat.
+    float startInterval = 0.12f;  ///< Seconds between repeats right after the delay.
+    float minInterval = 0.025f;   ///< Fastest interval, reached after rampTime.
+    float rampTime = 1.2f;        ///< Seconds to go from startInterval to minInterval.
+    float stepGrowth = 4.0f;      ///< Extra steps per repeat gained per second at full speed.
+    int maxStepsPerRepeat = 8;    ///< Upper bound on steps per repeat.
+};
+
+/**
+ * @class HoldRepeater
+ * @brief Turns a held button into an accelerating stream of steps based on elapsed time.
+ */
+class HoldRepeater {
+public:
+    explicit HoldRepeater(const RepeatCurve& curve = RepeatCurve());
+
+    /**
+     * @brief Replaces the repeat curve.
+     */
+    void setCurve(const RepeatCurve& curve);
+
+    /**
+     * @brief Starts holding. The caller applies the first step itself.
+     */
+    void press();
+
+    /**
+     * @brief Stops holding.
+     */
+    void release();
+
+    /**
+     * @brief Returns true while held.
+     */
+    bool isHeld() const { return held; }
+
+    /**
+     * @brief Advances the hold timer.
+     * @param dt Seconds since the previous update.
+     * @return Number of steps that became due during dt.
+     */
+    int update(float dt);
+
+private:
+    RepeatCurve curve;
+    bool held;
+    float heldTime;
+    float untilNext;
+
+    float intervalAt(float time) const;
+    int stepsAt(float time) const;
+};
@@ -0,0 +1,59 @@
+/**
+ * @file scroll_predictor.cpp
+ * @brief Implements ScrollPredictor.
+ */
+
+#include "scroll_predictor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float VELOCITY_SMOOTHING = 0.08f;  ///< Seconds over which velocity samples are averaged.
+const float JUMP_SCREENS = 4.0f;         ///< A single-frame move this far is a jump, not scrolling.
+const float MARGIN_SCREENS = 0.25f;      ///< Warm-up margin on both sides, even at rest.
+
+} // namespace
+
+/**
+ * @brief Constructs a predictor at rest at offset 0.
+ */
+ScrollPredictor::ScrollPredictor() : position(0.0f), resting(0.0f), velocity(0.0f), tracking(false) {}
+
+/**
+ * @brief Forgets the motion history.
+ */
+void ScrollPredictor::reset(float position) {
+    this->position = position;
+    resting = position;
+    velocity = 0.0f;
+    tracking = true;
+}
+
+/**
+ * @brief Updates the smoothed velocity from one frame's movement.
+ */
+void ScrollPredictor::update(float position, float restingPosition, float viewHeight, float dt) {
+    if (!tracking || dt <= 0.0f || std::fabs(position - this->position) > JUMP_SCREENS * viewHeight) {
+        reset(position);
+        resting = restingPosition;
+        return;
+    }
+
+    float sample = (position - this->position) / dt;
+    velocity += (sample - velocity) * (1.0f - std::exp(-dt / VELOCITY_SMOOTHING));
+    this->position = position;
+    resting = restingPosition;
+}
+
+/**
+ * @brief Returns the content span expected to be visible within the lookahead.
+ */
+void ScrollPredictor::predict(float viewHeight, float& top, float& bottom) const {
+    float ahead = position + velocity * LOOKAHEAD_SECONDS;
+    float reach = MAX_SCREENS_AHEAD * viewHeight;
+    float margin = MARGIN_SCREENS * viewHeight;
+
+    top = std::max(std::min({position, resting, ahead}), position - reach) - margin;
+    bottom = std::min(std::max({position, resting, ahead}), position + reach) + viewHeight + margin;
+}
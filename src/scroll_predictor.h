@@ -0,0 +1,82 @@
+/**
+ * @file scroll_predictor.h
+ * @brief Declares ScrollPredictor, which estimates what will scroll into view next.
+ *
+ * Covers requested only once their row is on screen arrive a few frames
+ * late during fast scrolling. The predictor smooths the scroll velocity
+ * and combines it with where the animation will come to rest, so the UI
+ * can start decoding covers and laying out rows before they appear.
+ */
+
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Counters describing how well prefetching kept ahead of scrolling.
+ */
+struct PrefetchStats {
+    size_t arrivals = 0;        ///< Covers that scrolled into view.
+    size_t readyOnArrival = 0;  ///< Arrivals already resident at the wanted size.
+    size_t requested = 0;       ///< Decodes queued ahead of the view.
+    size_t cancelled = 0;       ///< Queued decodes dropped after leaving the predicted window.
+    size_t layoutsWarmed = 0;   ///< Descriptions wrapped before their row was drawn.
+
+    /**
+     * @brief Returns the fraction of arrivals that were ready, or 0 if none arrived.
+     */
+    double hitRate() const { return arrivals ? static_cast<double>(readyOnArrival) / arrivals : 0.0; }
+};
+
+/**
+ * @class ScrollPredictor
+ * @brief Tracks a scroll offset and predicts the span it will show shortly.
+ */
+class ScrollPredictor {
+public:
+    ScrollPredictor();
+
+    /**
+     * @brief Forgets the motion history, e.g. after switching views.
+     */
+    void reset(float position);
+
+    /**
+     * @brief Feeds the scroll state of one frame.
+     *
+     * Moves of more than a few screens within one frame are treated as
+     * jumps (a search or relayout) and restart the history.
+     *
+     * @param position Current scroll offset.
+     * @param restingPosition Offset the current animation settles at.
+     * @param viewHeight Height of the visible area.
+     * @param dt Seconds since the previous frame.
+     */
+    void update(float position, float restingPosition, float viewHeight, float dt);
+
+    /**
+     * @brief Returns the content span expected to be visible within the lookahead.
+     *
+     * The span covers the current view, the view at the resting position and
+     * the view one lookahead along the measured velocity, plus a small margin,
+     * limited to MAX_SCREENS_AHEAD screens beyond the current view.
+     *
+     * @param viewHeight Height of the visible area.
+     * @param top Receives the first content offset of the span.
+     * @param bottom Receives the last content offset of the span.
+     */
+    void predict(float viewHeight, float& top, float& bottom) const;
+
+    /**
+     * @brief Returns the smoothed velocity in pixels per second, positive downwards.
+     */
+    float getVelocity() const { return velocity; }
+
+    static constexpr float LOOKAHEAD_SECONDS = 0.5f;
+    static constexpr float MAX_SCREENS_AHEAD = 3.0f;
+
+private:
+    float position;
+    float resting;
+    float velocity;
+    bool tracking;
+};
@@ -6,18 +6,82 @@
 
 #include "sdl_ui.h"
 #include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <SDL_image.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 namespace fs = std::filesystem;
 
+/// Atlas key of the pinned placeholder cover
+static const char* const PLACEHOLDER_KEY = "<placeholder>";
+
+/**
+ * @brief Returns the resident set size of this process in bytes, or 0 if unknown.
+ */
+static size_t residentMemoryBytes() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    if (statm >> pages >> resident) {
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Returns the user and system CPU time used by this process so far, in seconds.
+ */
+static double processCpuSeconds() {
+#ifndef _WIN32
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+#endif
+    return 0.0;
+}
+
 /**
  * @brief Constructs an SDLUI object and initializes colors.
  */
-SDLUI::SDLUI() : window(nullptr), renderer(nullptr), font(nullptr), initialized(false),
-                 selectedIndex(0), gameSelected(false), igdbInitialized(false) {
+SDLUI::SDLUI() : uiScale(1.0f), gridMetrics(), gridMetricsTile(-1), window(nullptr), renderer(nullptr), font(nullptr), openFontSize(0), initialized(false),
+                 gameExitEvent(static_cast<Uint32>(-1)), snapshotPending(false), detailsSuspended(false),
+                 igdbInitialized(false), selectedIndex(0), gameSelected(false), libraryPending(false),
+                 detailOpen(false), detailGame(0), dwellSeconds(DEFAULT_DWELL_SECONDS), dwellElapsed(0.0f),
+                 dwellGame(-1), dwellFired(false), viewMode(ViewMode::List),
+                 gridTileSize(GRID_DEFAULT_TILE_SIZE), gridTileTarget(GRID_DEFAULT_TILE_SIZE),
+                 heldKey(SDLK_UNKNOWN), heldButton(SDL_CONTROLLER_BUTTON_INVALID), heldStride(0),
+                 touchVelocity(0.0f), lastTouchTime(0),
+                 stickX(0.0f), stickY(0.0f), stickStepsX(0.0f), stickStepsY(0.0f),
+                 previewDecodes(0), textTextureCache(DEFAULT_TEXT_CACHE_BYTES),
+                 rowTextureCache(DEFAULT_ROW_CACHE_BYTES), rowTargetsSupported(false),
+                 placeholderArt(nullptr), placeholderLoaded(false), uploadsPerFrame(DEFAULT_UPLOADS_PER_FRAME),
+                 uploadBytesPerFrame(DEFAULT_UPLOAD_BYTES_PER_FRAME), prefetchReset(true),
+                 prefetchPitch(0), prefetchColumns(0), prefetchLevel(-1), visibleFirst(0), visibleLast(-1),
+                 predictedFirst(0), predictedLast(-1), drawnState(), drawnStateValid(false), rowsVersion(0),
+                 drawnCoverFirst(0), profilerPanel{0, 0, 0, 0}, showProfiler(false),
+                 profilerRefreshTime(0.0), lastDrawnTexture(nullptr) {
+    for (int level = 0; level < COVER_LEVEL_COUNT; ++level) {
+        coverLevels[level] = std::make_unique<CoverAtlas>(COVER_LEVEL_SIZES[level], ATLAS_PAGE_SIZE, 1);
+    }
+    previewAtlas = std::make_unique<CoverAtlas>(PREVIEW_CELL_SIZE, ATLAS_PAGE_SIZE, 1);
+    setTextureCacheBudgets(DEFAULT_COVER_CACHE_BYTES, DEFAULT_TEXT_CACHE_BYTES);
+
     // Initialize colors
     backgroundColor = {32, 32, 32, 255};    // Dark gray
     textColor = {200, 200, 200, 255};       // Light gray
@@ -35,12 +99,32 @@ SDLUI::~SDLUI() {
 
 /**
  * @brief Initializes SDL, SDL_ttf, and SDL_image for rendering.
+ *
+ * Runs the three init stages in order. Callers that want to overlap them
+ * with other startup work call initAssets(), initWindow() and finishInit()
+ * themselves.
+ *
+ * @param headless Hide the window and render in software, e.g. for benchmarks.
+ * @param backend GPU or software rendering; Auto falls back to software without a GPU.
  * @return True if initialization succeeds, false otherwise.
  */
-bool SDLUI::init() {
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
-        return false;
+bool SDLUI::init(bool headless, RenderBackend backend) {
+    return initAssets() && initWindow(headless, backend) && finishInit();
+}
+
+/**
+ * @brief Init stage that needs no window: assets, font, placeholder art and decode workers.
+ *
+ * Nothing here touches the video subsystem, the window or the renderer,
+ * so it may run on a worker thread concurrently with initWindow().
+ *
+ * @return False if SDL_ttf, SDL_image or the font could not be initialized.
+ */
+bool SDLUI::initAssets() {
+    // The font, placeholder and glyph atlases come from one mapped file next to the executable
+    std::string packPath = AssetPack::defaultPath();
+    if (!assets.open(packPath)) {
+        std::cerr << "Asset pack " << packPath << " unavailable, loading loose asset files" << std::endl;
     }
 
     if (TTF_Init() < 0) {
@@ -48,41 +132,257 @@ bool SDLUI::init() {
         return false;
     }
 
+    // Initialize SDL_image
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    // Open the font at the 1x size; finishInit() reopens it only if the display needs another scale
+    if (!openFont(UILayout::compute(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, 1.0f, 1.0f).fontSize)) {
+        return false;
+    }
+
+    // Decoded now, uploaded into its pinned atlas slot once there is a renderer
+    placeholderArt = decodePlaceholder();
+
+    imageLoader.setAssetPack(&assets);
+    imageLoader.start();
+    return true;
+}
+
+/**
+ * @brief Init stage for the video subsystem, the window and the renderer. Main thread only.
+ * @param headless Hide the window and render in software.
+ * @param backend GPU or software rendering; Auto falls back to software without a GPU.
+ * @return False if the window or renderer could not be created.
+ */
+bool SDLUI::initWindow(bool headless, RenderBackend backend) {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    gameExitEvent = SDL_RegisterEvents(1);
+
+    // Pads are optional; already connected ones arrive as SDL_CONTROLLERDEVICEADDED
+    if (SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) < 0) {
+        std::cerr << "Game controller support unavailable: " << SDL_GetError() << std::endl;
+    }
+
+    Uint32 windowFlags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI;
+    windowFlags |= headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
     window = SDL_CreateWindow("NES Game Launcher",
                             SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-                            WINDOW_WIDTH, WINDOW_HEIGHT,
-                            SDL_WINDOW_SHOWN);
+                            DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT,
+                            windowFlags);
 
     if (!window) {
         std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    SDL_SetWindowMinimumSize(window, MIN_WINDOW_WIDTH, MIN_WINDOW_HEIGHT);
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer) {
-        std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+    // Headless runs (CI, the benchmark) and GPU-less kiosks composite in software
+    bool software = headless || backend == RenderBackend::Software;
+    if (!software) {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        if (!renderer) {
+            if (backend == RenderBackend::Gpu) {
+                std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+                return false;
+            }
+            std::cerr << "No accelerated renderer (" << SDL_GetError() << "), rendering in software" << std::endl;
+            software = true;
+        }
+    }
+    if (software && !createSoftwareRenderer()) {
         return false;
     }
+    rowTargetsSupported = SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+    return true;
+}
 
-    // Initialize SDL_image
-    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
-        return false;
+/**
+ * @brief Final init stage, after initAssets() and initWindow(). Main thread only.
+ * @return False if no font could be opened for the display's scale.
+ */
+bool SDLUI::finishInit() {
+    // Covers decode in the background; previews or the placeholder are shown until they are resident
+    for (auto& atlas : coverLevels) {
+        atlas->setRenderer(renderer, compositor.get());
     }
+    previewAtlas->setRenderer(renderer, compositor.get());
+    loadPlaceholder();
 
-    font = TTF_OpenFont("Urbanist-VariableFont_wght.ttf", 18);
+    // Computes the geometry for the real drawable size and opens the font at its scale
+    updateLayout();
     if (!font) {
-        font = TTF_OpenFont("../Urbanist-VariableFont_wght.ttf", 18);
-        if (!font) {
-            std::cerr << "Failed to load font! TTF_Error: " << TTF_GetError() << std::endl;
-            return false;
-        }
+        return false;
     }
 
     initialized = true;
     return true;
 }
 
+/**
+ * @brief Creates the software compositor's framebuffer and renderer and points the atlases at them.
+ * @param viewOnly Size the framebuffer to the window rather than the largest display.
+ * @return False if the framebuffer or renderer could not be created.
+ */
+bool SDLUI::createSoftwareRenderer(bool viewOnly) {
+    if (!compositor) {
+        compositor = std::make_unique<SoftwareCompositor>();
+    }
+    renderer = compositor->create(window, viewOnly);
+    if (!renderer) {
+        return false;
+    }
+    for (auto& atlas : coverLevels) {
+        atlas->setRenderer(renderer, compositor.get());
+    }
+    previewAtlas->setRenderer(renderer, compositor.get());
+    rowTargetsSupported = SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+    return true;
+}
+
+/**
+ * @brief Recomputes the screen geometry after a resize, fullscreen toggle or display change.
+ *
+ * This is the only place layout happens: frames read the cached UILayout,
+ * and descriptions re-wrap lazily as their rows are drawn at the new width.
+ */
+void SDLUI::updateLayout() {
+    if (!window || !renderer) return;
+
+    int windowW = 0, windowH = 0, pixelW = 0, pixelH = 0;
+    SDL_GetWindowSize(window, &windowW, &windowH);
+    if (compositor) {
+        // The framebuffer is larger than the window; only the window's part is drawn
+        SoftwareCompositor::getViewSize(window, pixelW, pixelH);
+        if (!compositor->fits(pixelW, pixelH)) {
+            // Moved to a display larger than any seen at startup; textures go with the renderer
+            clearTextureCache();
+            placeholderLoaded = false;
+            if (!createSoftwareRenderer()) return;
+            loadPlaceholder();
+        }
+        compositor->invalidateAll();
+    } else if (SDL_GetRendererOutputSize(renderer, &pixelW, &pixelH) != 0) {
+        pixelW = windowW;
+        pixelH = windowH;
+    }
+    float pixelRatio = windowW > 0 ? static_cast<float>(pixelW) / windowW : 1.0f;
+
+    // HiDPI backends report the ratio directly; elsewhere fall back to the display DPI
+    float systemScale = pixelRatio;
+    if (pixelRatio <= 1.0f) {
+        float dpi = 0.0f;
+        int display = SDL_GetWindowDisplayIndex(window);
+        if (display >= 0 && SDL_GetDisplayDPI(display, &dpi, nullptr, nullptr) == 0 && dpi > 0.0f) {
+            systemScale = std::clamp(dpi / 96.0f, 1.0f, 4.0f);
+        }
+    }
+
+    UILayout next = UILayout::compute(pixelW, pixelH, systemScale * uiScale, pixelRatio);
+    if (font && layout.sameSize(next)) return;
+    prefetchReset = true;
+
+    const int oldPitch = layout.itemPitch;
+    layout = next;
+    gridMetricsTile = -1;
+    rowTextureCache.clear();  // Rows were composited at the old width and scale
+    updateCoverPageLimits();
+
+    if (!font || layout.fontSize != openFontSize) {
+        openFont(layout.fontSize);
+    } else {
+        layoutCache.clear();  // Wrap widths changed
+    }
+
+    // Keep the same rows on screen across the change
+    if (oldPitch > 0) {
+        listScroll.jumpTo(listScroll.getPosition() * layout.itemPitch / oldPitch);
+    }
+    updateScrollBounds();
+    ensureSelectionVisible();
+}
+
+/**
+ * @brief Opens the UI font at a point size, replacing the current one.
+ *
+ * The font is read in place from the asset pack, and text at sizes the
+ * pack has a glyph atlas for is composed from it instead of rasterized.
+ * Without a pack the font file is looked up next to and above the
+ * working directory.
+ *
+ * @return False if the font could not be opened; the old font is kept.
+ */
+bool SDLUI::openFont(int size) {
+    static const char* const FONT_PATHS[] = {
+        "Urbanist-VariableFont_wght.ttf", "../Urbanist-VariableFont_wght.ttf"
+    };
+
+    TTF_Font* opened = nullptr;
+    if (SDL_RWops* packed = assets.openEntry(AssetPack::FONT)) {
+        opened = TTF_OpenFontRW(packed, 1, size);
+    } else {
+        for (const char* path : FONT_PATHS) {
+            opened = TTF_OpenFont(path, size);
+            if (opened) break;
+        }
+    }
+    if (!opened) {
+        std::cerr << "Failed to load font! TTF_Error: " << TTF_GetError() << std::endl;
+        return false;
+    }
+
+    if (font) {
+        TTF_CloseFont(font);
+    }
+    font = opened;
+    openFontSize = size;
+
+    AssetPack::Blob glyphs = assets.find(GlyphAtlas::entryName(size));
+    glyphAtlas.load(glyphs.data, glyphs.size);
+
+    // Text textures, wrapped layouts and composited rows were made with the old font
+    textTextureCache.clear();
+    rowTextureCache.clear();
+    layoutCache.clear();
+    return true;
+}
+
+/**
+ * @brief Switches between a window and borderless desktop fullscreen.
+ */
+void SDLUI::toggleFullscreen() {
+    bool fullscreen = (SDL_GetWindowFlags(window) & SDL_WINDOW_FULLSCREEN) != 0;
+    if (SDL_SetWindowFullscreen(window, fullscreen ? 0 : SDL_WINDOW_FULLSCREEN_DESKTOP) != 0) {
+        std::cerr << "Failed to toggle fullscreen! SDL_Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+    updateLayout();
+}
+
+/**
+ * @brief Sets the hold-to-repeat acceleration for keys and for controller buttons.
+ * @param keyboard Curve for held arrow and page keys.
+ * @param controller Curve for held d-pad directions and shoulder buttons.
+ */
+void SDLUI::setRepeatCurves(const RepeatCurve& keyboard, const RepeatCurve& controller) {
+    keyRepeatCurve = keyboard;
+    padRepeatCurve = controller;
+}
+
+/**
+ * @brief Sets a user scale applied on top of the HiDPI or display DPI scale.
+ * @param scale Multiplier for every element and the font, clamped to 0.5-4.
+ */
+void SDLUI::setUiScale(float scale) {
+    uiScale = std::clamp(scale, 0.5f, 4.0f);
+    updateLayout();
+}
+
 /**
  * @brief Initializes the IGDB client for retrieving game metadata.
  * @param client_id The client ID for IGDB API authentication.
@@ -98,343 +398,2171 @@ bool SDLUI::initIGDB(const std::string& client_id, const std::string& client_sec
 }
 
 /**
- * @brief Loads an image file into an SDL texture.
- * @param path The file path of the image.
- * @return The loaded SDL_Texture or nullptr if loading fails.
+ * @brief Loads the placeholder art into a pinned atlas slot.
+ *
+ * The art is normally decoded during initAssets(); covers go through the
+ * background loader so they never block a frame.
  */
-SDL_Texture* SDLUI::loadTextureFromFile(const std::string& path) {
-    auto it = textureCache.find(path);
-    if (it != textureCache.end()) {
-        return it->second;
+void SDLUI::loadPlaceholder() {
+    if (!placeholderArt) {
+        placeholderArt = decodePlaceholder();
+    }
+    if (!placeholderArt) {
+        std::cerr << "Failed to load placeholder art; covers will be blank until loaded" << std::endl;
+        return;
     }
+    placeholderLoaded = coverLevels[LIST_COVER_LEVEL]->insert(PLACEHOLDER_KEY, placeholderArt, true);
+}
 
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
-        std::cerr << "Failed to load image " << path << "! SDL_image Error: " << IMG_GetError() << std::endl;
-        
-        // Try loading from the assets directory
-        std::string assetPath = "../assets/" + path;
-        surface = IMG_Load(assetPath.c_str());
-        
-        if (!surface) {
-            std::cerr << "Failed to load image from assets directory: " << assetPath << std::endl;
-            return nullptr;
+/**
+ * @brief Decodes the placeholder art at the list cover size, from the asset pack or loose files.
+ * @return The surface, or nullptr if it could not be found. The caller owns it.
+ */
+SDL_Surface* SDLUI::decodePlaceholder() const {
+    const int size = coverLevels[LIST_COVER_LEVEL]->getCellSize();
+    if (assets.isOpen()) {
+        if (SDL_Surface* surface = ImageLoader::decode(AssetPack::PLACEHOLDER_URI, size, &assets)) {
+            return surface;
         }
     }
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        std::cerr << "Failed to create texture from " << path << "! SDL Error: " << SDL_GetError() << std::endl;
-        SDL_FreeSurface(surface);
-        return nullptr;
+    for (const char* path : {"assets/not_found.png", "../assets/not_found.png"}) {
+        if (SDL_Surface* surface = ImageLoader::decode(path, size)) {
+            return surface;
+        }
     }
-
-    SDL_FreeSurface(surface);
-    textureCache[path] = texture;
-    return texture;
+    return nullptr;
 }
 
 /**
- * @brief Loads metadata for a list of games.
- * @param games A vector containing game filenames.
+ * @brief Picks the smallest thumbnail level that covers a tile without upscaling.
+ * @param pixels Edge length of the tile on screen.
+ * @return Index into COVER_LEVEL_SIZES.
  */
-void SDLUI::loadGameMetadata(const std::vector<std::string>& games) {
-    std::cout << "Loading metadata for " << games.size() << " games..." << std::endl;
-    gameList.clear();
-    
-    // Pre-allocate space for better performance
-    gameList.reserve(games.size());
-    
-    for (const auto& game : games) {
-        try {
-            std::cout << "Processing game: " << game << std::endl;
-            gameList.push_back(igdbClient.fetchGameMetadata(game));
-            
-            // Pre-load the cover image texture if available
-            if (!gameList.back().imagePath.empty()) {
-                loadTextureFromFile(gameList.back().imagePath);
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Error processing game " << game << ": " << e.what() << std::endl;
-            // Create basic metadata for this game
-            GameMetadata basic;
-            basic.filename = game;
-            basic.title = game.substr(0, game.find_last_of('.'));
-            basic.description = "Classic NES game";
-            basic.releaseYear = "Unknown";
-            basic.publisher = "Unknown";
-            basic.genre = "Unknown";
-            gameList.push_back(basic);
+int SDLUI::coverLevelFor(int pixels) const {
+    for (int level = 0; level < COVER_LEVEL_COUNT; ++level) {
+        if (COVER_LEVEL_SIZES[level] >= pixels) {
+            return level;
         }
     }
-    
-    std::cout << "Finished loading metadata for " << gameList.size() << " games" << std::endl;
+    return COVER_LEVEL_COUNT - 1;
 }
 
 /**
- * @brief Renders text onto the screen at a specified position.
- * @param text The text string to render.
- * @param x The x-coordinate for rendering.
- * @param y The y-coordinate for rendering.
- * @param color The SDL_Color to use for text rendering.
+ * @brief Queues a cover for the batched atlas draw without blocking.
+ *
+ * Draws the placeholder while no level of the cover is resident.
+ *
+ * @param path The file path of the cover image.
+ * @param dst Destination rectangle on screen.
  */
-void SDLUI::renderText(const std::string& text, int x, int y, const SDL_Color& color) {
-    if (!font) return;
-
-    SDL_Texture* texture = getOrCreateTextTexture(text, color);
-    if (!texture) return;
-
-    int w, h;
-    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-    SDL_Rect dstRect = {x, y, w, h};
-    SDL_RenderCopy(renderer, texture, NULL, &dstRect);
+void SDLUI::queueCoverDraw(const std::string& path, const SDL_Rect& dst) {
+    if (!queueResidentCover(path, dst) && placeholderLoaded) {
+        coverLevels[LIST_COVER_LEVEL]->queueDraw(PLACEHOLDER_KEY, dst);
+    }
 }
 
 /**
- * @brief Renders wrapped text within a specified boundary.
- * @param text The text string to render.
- * @param bounds The SDL_Rect specifying the text boundaries.
- * @param color The SDL_Color to use for text rendering.
+ * @brief Queues a game's cover, falling back to its preview, then the placeholder.
+ *
+ * A game whose cover is still on its way is painted with the blurred
+ * preview from its metadata, so a fresh screen looks like its covers
+ * before any image file has been read.
+ *
+ * @param game The game whose cover to draw.
+ * @param dst Destination rectangle on screen.
  */
-void SDLUI::renderWrappedText(const std::string& text, const SDL_Rect& bounds, const SDL_Color& color) {
-    if (text.empty()) {
+void SDLUI::queueGameCover(GameId game, const SDL_Rect& dst) {
+    const std::string& path = catalog.imagePath(game);
+    if (!path.empty() && queueResidentCover(path, dst)) {
         return;
     }
+    if (!queuePreviewDraw(game, dst) && placeholderLoaded) {
+        coverLevels[LIST_COVER_LEVEL]->queueDraw(PLACEHOLDER_KEY, dst);
+    }
+}
 
-    // Split text into lines and render
-    std::string remainingText = text;
-    int y = bounds.y;
-    int lineWidth = bounds.w;
-    int linesRendered = 0;
-    
-    // Check if this text should have a Read More link
-    bool shouldAddReadMore = text.find(" Read More") != std::string::npos;
-    if (shouldAddReadMore) {
-        // Remove the " Read More" from the text before processing
-        remainingText = text.substr(0, text.find(" Read More"));
+/**
+ * @brief Queues the best resident level of a cover and requests the wanted one.
+ *
+ * The thumbnail level matching the tile size is requested if it is not
+ * resident. Meanwhile the nearest resident level is drawn, preferring
+ * smaller ones.
+ *
+ * @param path The file path of the cover image.
+ * @param dst Destination rectangle on screen.
+ * @return false if no level is resident yet and nothing was queued.
+ */
+bool SDLUI::queueResidentCover(const std::string& path, const SDL_Rect& dst) {
+    int wanted = coverLevelFor(dst.w);
+    if (coverLevels[wanted]->touch(path)) {
+        coverLevels[wanted]->queueDraw(path, dst);
+        return true;
     }
-    
-    while (!remainingText.empty() && linesRendered < MAX_DESCRIPTION_LINES) {
-        // Calculate how many characters fit in one line
-        int textWidth, textHeight;
-        TTF_SizeText(font, remainingText.c_str(), &textWidth, &textHeight);
-        
-        // Ensure we don't divide by zero
-        if (textWidth <= 0 || remainingText.empty()) {
-            break;
-        }
-        
-        // Calculate characters per line, ensuring at least one character
-        int charsPerLine = std::max(1, (lineWidth * (int)remainingText.length()) / textWidth);
-        
-        // Ensure we don't exceed string length
-        charsPerLine = std::min(charsPerLine, (int)remainingText.length());
-        
-        // Find the last space before the cut-off point
-        size_t lineEnd = remainingText.find_last_of(" \n", charsPerLine);
-        if (lineEnd == std::string::npos || lineEnd > charsPerLine) {
-            lineEnd = charsPerLine;
-        }
-        
-        // Ensure lineEnd is valid
-        lineEnd = std::min(lineEnd, remainingText.length());
-        
-        // Extract and render the line
-        std::string line = remainingText.substr(0, lineEnd);
-        
-        // If this is the second line and we should add Read More
-        if (linesRendered == 1 && shouldAddReadMore) {
-            // Calculate how much space we need for "Read More"
-            int readMoreWidth, readMoreHeight;
-            std::string readMore = " Read More";
-            TTF_SizeText(font, readMore.c_str(), &readMoreWidth, &readMoreHeight);
-            
-            // Calculate the width of the current line
-            int currentLineWidth;
-            TTF_SizeText(font, line.c_str(), &currentLineWidth, &readMoreHeight);
-            
-            // If we have enough space, add "Read More" to the line
-            if (lineWidth - currentLineWidth > readMoreWidth + 10) {  // 10 pixels padding
-                renderText(line, bounds.x, y, color);
-                renderText(readMore, bounds.x + currentLineWidth + 5, y, linkColor);
-            } else {
-                // If not enough space, truncate the line and add "Read More" at the end
-                // Find the last space before the cut-off point that leaves room for "Read More"
-                while (currentLineWidth + readMoreWidth + 10 > lineWidth && !line.empty()) {
-                    line = line.substr(0, line.find_last_of(" "));
-                    TTF_SizeText(font, line.c_str(), &currentLineWidth, &readMoreHeight);
-                }
-                renderText(line, bounds.x, y, color);
-                renderText(readMore, bounds.x + currentLineWidth + 5, y, linkColor);
-            }
-        } else {
-            renderText(line, bounds.x, y, color);
-        }
-        
-        // Move to next line
-        y += DESCRIPTION_LINE_HEIGHT;
-        linesRendered++;
-        
-        // Move to next portion of text, handling the case where lineEnd is at the end
-        if (lineEnd >= remainingText.length()) {
-            break;
-        }
-        remainingText = remainingText.substr(lineEnd + 1);
+
+    if (failedImages.find(path) == failedImages.end() && !coverDeferred(path, wanted)) {
+        imageLoader.request(path, COVER_LEVEL_SIZES[wanted]);
+    }
+
+    // Stream in: show a blurrier (or sharper) level until the wanted one arrives
+    int level = residentCoverLevel(path, wanted);
+    if (level < 0) {
+        return false;
     }
+    coverLevels[level]->touch(path, false);  // The lookup was the wanted level's
+    coverLevels[level]->queueDraw(path, dst);
+    return true;
 }
 
 /**
- * @brief Renders the list of available games on the screen.
+ * @brief Queues the blurred preview of a game's cover, decoding it on first use.
+ *
+ * Decoding is pure arithmetic on the catalog's hash, without any I/O, but
+ * is capped per frame. Beyond the cap the tile is filled with the cover's
+ * dominant color and the preview follows in a later frame.
+ *
+ * @return false if the game has neither a preview nor a dominant color.
  */
-void SDLUI::renderGameList() {
-    // Clear the screen
-    SDL_SetRenderDrawColor(renderer, backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
-    SDL_RenderClear(renderer);
-
-    // Render game list
-    int y = GAME_ITEM_PADDING;
-    for (size_t i = 0; i < gameList.size(); ++i) {
-        const auto& game = gameList[i];
-        
-        // Draw selection background if this is the selected item
-        if (i == selectedIndex) {
-            SDL_SetRenderDrawColor(renderer, selectedColor.r, selectedColor.g, selectedColor.b, selectedColor.a);
-            SDL_Rect selectionRect = {0, y - 5, WINDOW_WIDTH, GAME_ITEM_HEIGHT + 10};
-            SDL_RenderFillRect(renderer, &selectionRect);
+bool SDLUI::queuePreviewDraw(GameId game, const SDL_Rect& dst) {
+    const std::string& hash = catalog.previewHash(game);
+    if (!hash.empty()) {
+        if (previewAtlas->touch(hash)) {
+            previewAtlas->queueDraw(hash, dst);
+            return true;
         }
-
-        // Render game cover image
-        if (!game.imagePath.empty()) {
-            SDL_Texture* coverTexture = loadTextureFromFile(game.imagePath);
-            if (coverTexture) {
-                SDL_Rect coverRect = {GAME_ITEM_PADDING, y, COVER_IMAGE_SIZE, COVER_IMAGE_SIZE};
-                SDL_RenderCopy(renderer, coverTexture, NULL, &coverRect);
+        if (previewDecodes < MAX_PREVIEW_DECODES_PER_FRAME) {
+            previewDecodes++;
+            if (SDL_Surface* preview = CoverPreview::decode(hash, PREVIEW_CELL_SIZE)) {
+                bool resident = previewAtlas->insert(hash, preview);
+                SDL_FreeSurface(preview);
+                if (resident) {
+                    previewAtlas->queueDraw(hash, dst);
+                    return true;
+                }
             }
         }
+    }
 
-        // Render game title
-        renderText(game.title, TEXT_START_X, y, textColor);
+    const uint32_t color = catalog.dominantColor(game);
+    if (color == 0) {
+        return false;
+    }
+    fillRect(dst, {static_cast<Uint8>(color >> 16), static_cast<Uint8>(color >> 8), static_cast<Uint8>(color), 255});
+    return true;
+}
 
-        // Render game details in one line
-        std::string details = game.releaseYear + " | " + game.publisher + " | " + game.genre;
-        renderText(details, TEXT_START_X, y + 25, textColor);
+/**
+ * @brief Returns what a game's cover would be drawn from right now.
+ * @return A thumbnail level, COVER_LEVEL_COUNT for the preview, or -1 for the
+ *         placeholder or dominant color.
+ */
+int SDLUI::coverSource(GameId game, int wanted) const {
+    const std::string& path = catalog.imagePath(game);
+    int level = path.empty() ? -1 : residentCoverLevel(path, wanted);
+    if (level < 0 && previewAtlas->contains(catalog.previewHash(game))) {
+        return COVER_LEVEL_COUNT;
+    }
+    return level;
+}
 
-        // Render description with Read More link only if game is found in IGDB
-        SDL_Rect descBounds = {TEXT_START_X, y + 50, WINDOW_WIDTH - TEXT_START_X - GAME_ITEM_PADDING, 40};
-        if (!game.igdbUrl.empty()) {
-            // Game found in IGDB, show description with Read More
-            renderWrappedText(game.description + " Read More", descBounds, textColor);
-        } else {
-            // Game not found in IGDB, show description without Read More
-            renderWrappedText(game.description, descBounds, textColor);
+/**
+ * @brief Returns the thumbnail level a cover would be drawn from right now.
+ *
+ * The wanted level if resident, otherwise the nearest resident one,
+ * preferring smaller levels.
+ *
+ * @return The level, or -1 if the placeholder would be drawn.
+ */
+int SDLUI::residentCoverLevel(const std::string& path, int wanted) const {
+    if (coverLevels[wanted]->contains(path)) {
+        return wanted;
+    }
+    for (int distance = 1; distance < COVER_LEVEL_COUNT; ++distance) {
+        for (int level : {wanted - distance, wanted + distance}) {
+            if (level >= 0 && level < COVER_LEVEL_COUNT && coverLevels[level]->contains(path)) {
+                return level;
+            }
         }
-
-        y += GAME_ITEM_HEIGHT + GAME_ITEM_PADDING;
     }
-
-    SDL_RenderPresent(renderer);
+    return -1;
 }
 
 /**
- * @brief Handles user input, such as keyboard and mouse events.
+ * @brief Submits the queued covers of every thumbnail level.
  */
-void SDLUI::handleInput() {
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
-                selectedIndex = -1;  // Signal to exit
-                return;
-                
-            case SDL_KEYDOWN:
-                switch (event.key.keysym.sym) {
-                    case SDLK_UP:
-                        if (selectedIndex > 0) selectedIndex--;
-                        break;
-                    case SDLK_DOWN:
-                        if (selectedIndex < static_cast<int>(gameList.size() - 1)) selectedIndex++;
-                        break;
-                    case SDLK_RETURN:
-                        gameSelected = true;  // Set flag to indicate game was selected
-                        return;
-                    case SDLK_ESCAPE:
-                        selectedIndex = -1;  // Signal to exit
-                        return;
-                }
-                break;
-                
-            case SDL_MOUSEBUTTONDOWN:
-                if (event.button.button == SDL_BUTTON_LEFT) {
-                    // Calculate which game item was clicked
-                    int clickY = event.button.y;
-                    int itemY = GAME_ITEM_PADDING;
-                    
-                    for (size_t i = 0; i < gameList.size(); ++i) {
-                        const auto& game = gameList[i];
-                        
-                        // Check if click is in the description area and game has IGDB URL
-                        if (!game.igdbUrl.empty() && 
-                            clickY >= itemY + 50 && 
-                            clickY <= itemY + 90 && 
-                            event.button.x >= TEXT_START_X) {
-                            
-                            // Open the URL in the default browser
-                            #ifdef _WIN32
-                                std::string command = "start " + game.igdbUrl;
-                            #else
-                                std::string command = "xdg-open \"" + game.igdbUrl + "\"";
-                            #endif
-                            system(command.c_str());
-                            return;
-                        }
-                        
-                        itemY += GAME_ITEM_HEIGHT + GAME_ITEM_PADDING;
-                    }
-                }
-                break;
-        }
+void SDLUI::flushCovers() {
+    for (auto& atlas : coverLevels) {
+        atlas->flush(renderer, frameStats);
     }
+    previewAtlas->flush(renderer, frameStats);
+    lastDrawnTexture = nullptr;
 }
 
 /**
- * @brief Displays the game list and handles user interaction.
- * @param games A vector containing game filenames.
- * @return The index of the selected game, or -1 if the user exits.
+ * @brief Copies decoded covers into the atlas, within the per-frame budget.
+ *
+ * At most uploadsPerFrame covers or uploadBytesPerFrame bytes are uploaded
+ * per call, except that one oversized image is always allowed so it
+ * cannot starve.
  */
+void SDLUI::uploadDecodedImages() {
+    int uploaded = 0;
+    size_t uploadedBytes = 0;
+    DecodedImage image;
 
-int SDLUI::displayGameList(const std::vector<std::string>& games) {
-    loadGameMetadata(games);
-    gameSelected = false;  // Reset selection flag
-    
-    while (true) {
-        renderGameList();
-        handleInput();
-        
-        if (selectedIndex == -1) {
-            return -1;  // Exit selected
+    while (uploaded < uploadsPerFrame) {
+        size_t remaining = uploaded == 0 ? SIZE_MAX : uploadBytesPerFrame - std::min(uploadedBytes, uploadBytesPerFrame);
+        if (!imageLoader.popCompleted(image, remaining)) {
+            break;
         }
-        
-        if (gameSelected) {
-            return selectedIndex;  // Return the selected game index
+
+        if (!image.surface) {
+            failedImages.insert(image.path);
+            continue;
         }
-        
-        SDL_Delay(16);  // Cap at ~60 FPS
+
+        uploadedBytes += ImageLoader::surfaceBytes(image.surface);
+        int level = coverLevelFor(image.size);
+        if (!coverLevels[level]->insert(image.path, image.surface)) {
+            deferredCovers[level].insert(image.path);  // Decoding it again would only be refused again
+        }
+        SDL_FreeSurface(image.surface);
+        uploaded++;
     }
 }
 
 /**
- * @brief Displays an error message on the screen.
- * @param message The error message to display.
+ * @brief Returns true if a cover was refused by a full level that still has no room.
+ *
+ * Once the level can take a cover again the path is forgotten, so the
+ * caller requests it again.
  */
-
+bool SDLUI::coverDeferred(const std::string& path, int level) {
+    auto& deferred = deferredCovers[level];
+    if (deferred.empty() || !deferred.count(path)) {
+        return false;
+    }
+    if (!coverLevels[level]->hasRoom()) {
+        return true;
+    }
+    deferred.erase(path);
+    return false;
+}
+
+/**
+ * @brief Blends a translucent rectangle over what has been drawn so far.
+ *
+ * The software renderer blends fills one pixel at a time, so in software
+ * mode the queued draws are flushed and the compositor blends with SIMD.
+ */
+void SDLUI::blendRect(const SDL_Rect& rect, const SDL_Color& color) {
+    if (compositor) {
+        SDL_RenderFlush(renderer);
+        compositor->fillBlend(rect, color);
+        frameStats.drawCalls++;
+        return;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    fillRect(rect, color);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+/**
+ * @brief Marks what changed since the last software frame as needing a redraw.
+ *
+ * Scrolling, zooming, a new search result, a resize or opening, closing
+ * or filling in the detail pane change every pixel. Otherwise only the
+ * old and new selection, covers that streamed in at another level since
+ * they were drawn, the detail pane when its images stream in and the
+ * profiler panel are redrawn.
+ */
+void SDLUI::collectDamage() {
+    const bool grid = viewMode == ViewMode::Grid;
+    const GridMetrics metrics = getGridMetrics();
+    const int scroll = static_cast<int>(activeScroll().getPosition());
+
+    DrawnState state = {viewMode, scroll, selectedIndex, grid ? metrics.tileSize : 0, layout.width,
+                        layout.height, layout.fontSize, rowsVersion, showProfiler,
+                        detailOpen ? static_cast<int>(detailGame) : -1, detailLoader.getVersion(),
+                        detailOpen ? detailImageSignature() : 0u};
+    const DrawnState& drawn = drawnState;
+    bool full = !drawnStateValid || state.view != drawn.view || state.scroll != drawn.scroll ||
+                state.tileSize != drawn.tileSize || state.width != drawn.width || state.height != drawn.height ||
+                state.fontSize != drawn.fontSize || state.rowsVersion != drawn.rowsVersion ||
+                state.profiler != drawn.profiler || state.detail != drawn.detail ||
+                (detailOpen && state.detailVersion != drawn.detailVersion);
+
+    if (full) {
+        compositor->invalidateAll();
+    } else {
+        if (state.selected != drawn.selected) {
+            compositor->invalidate(selectionBounds(drawn.selected));
+            compositor->invalidate(selectionBounds(state.selected));
+            if (grid) {
+                compositor->invalidate({0, metrics.viewHeight, layout.width, layout.statusHeight});
+            }
+        }
+        if (showProfiler) {
+            compositor->invalidate(profilerPanel);
+        }
+        if (state.detailImages != drawn.detailImages) {
+            compositor->invalidate({layout.detailX, layout.detailY, layout.detailWidth, layout.detailHeight});
+        }
+    }
+
+    // Covers whose best resident level differs from the one they were drawn with
+    const int pitch = grid ? metrics.pitch : layout.itemPitch;
+    const int columns = grid ? metrics.columns : 1;
+    const int wanted = coverLevelFor(grid ? metrics.tileSize : layout.coverSize);
+    const float viewHeight = static_cast<float>(grid ? metrics.viewHeight : layout.height);
+    int first, last;
+    itemsInSpan(static_cast<float>(scroll), scroll + viewHeight, pitch, columns, first, last);
+
+    coverSources.assign(std::max(0, last - first + 1), -1);
+    const bool comparable = !full && first == drawnCoverFirst && coverSources.size() == drawnCoverSources.size();
+    for (int i = first; i <= last; ++i) {
+        int8_t source = static_cast<int8_t>(coverSource(gameAtRow(i), wanted));
+        coverSources[i - first] = source;
+        if (comparable && source != drawnCoverSources[i - first]) {
+            compositor->invalidate(coverBounds(i));
+        }
+    }
+    drawnCoverSources.swap(coverSources);
+    drawnCoverFirst = first;
+
+    drawnState = state;
+    drawnStateValid = true;
+}
+
+/**
+ * @brief Returns the area covered by the selection highlight of an item.
+ */
+SDL_Rect SDLUI::selectionBounds(int index) const {
+    if (index < 0) return {0, 0, 0, 0};
+    if (viewMode == ViewMode::Grid) {
+        const GridMetrics grid = getGridMetrics();
+        const int scroll = static_cast<int>(gridScroll.getPosition());
+        const int border = layout.px(4);
+        return {grid.offsetX + (index % grid.columns) * grid.pitch - border,
+                layout.gridGap + (index / grid.columns) * grid.pitch - scroll - border,
+                grid.tileSize + 2 * border, grid.tileSize + 2 * border};
+    }
+    const int scroll = static_cast<int>(listScroll.getPosition());
+    return {0, layout.itemPadding + index * layout.itemPitch - scroll - layout.selectionInset, layout.width,
+            layout.itemHeight + 2 * layout.selectionInset};
+}
+
+/**
+ * @brief Returns the on-screen rectangle of an item's cover.
+ */
+SDL_Rect SDLUI::coverBounds(int index) const {
+    if (viewMode == ViewMode::Grid) {
+        const GridMetrics grid = getGridMetrics();
+        const int scroll = static_cast<int>(gridScroll.getPosition());
+        return {grid.offsetX + (index % grid.columns) * grid.pitch,
+                layout.gridGap + (index / grid.columns) * grid.pitch - scroll, grid.tileSize, grid.tileSize};
+    }
+    const int scroll = static_cast<int>(listScroll.getPosition());
+    return {layout.itemPadding, layout.itemPadding + index * layout.itemPitch - scroll, layout.coverSize,
+            layout.coverSize};
+}
+
+/**
+ * @brief Draws a texture and updates the per-frame draw counters.
+ */
+void SDLUI::drawTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst) {
+    SDL_RenderCopy(renderer, texture, src, dst);
+    frameStats.drawCalls++;
+    if (texture != lastDrawnTexture) {
+        frameStats.textureSwitches++;
+        lastDrawnTexture = texture;
+    }
+}
+
+/**
+ * @brief Fills a rectangle and updates the per-frame draw counters.
+ */
+void SDLUI::fillRect(const SDL_Rect& rect, const SDL_Color& color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+    frameStats.drawCalls++;
+}
+
+/**
+ * @brief Resets the per-frame draw counters and advances the atlas frame.
+ */
+void SDLUI::beginFrame() {
+    frameStats = RenderStats();
+    lastDrawnTexture = nullptr;
+    for (auto& atlas : coverLevels) {
+        atlas->beginFrame();
+    }
+    previewAtlas->beginFrame();
+    previewDecodes = 0;
+}
+
+/**
+ * @brief Publishes the counters of the frame that was just presented.
+ */
+void SDLUI::endFrame() {
+    lastFrameStats = frameStats;
+}
+
+/**
+ * @brief Loads metadata for a list of games.
+ * @param games A vector containing game filenames.
+ */
+void SDLUI::loadGameMetadata(const std::vector<std::string>& games) {
+    std::vector<GameMetadata> fetched = fetchGameMetadata(games);
+    size_t metadataBytes = 0;  // What the same games cost as GameMetadata structs
+    for (const GameMetadata& game : fetched) {
+        metadataBytes += GameCatalog::metadataBytes(game);
+    }
+
+    setGameLibrary(std::move(fetched));
+    if (!catalog.empty()) {
+        std::cout << "Catalog memory: " << catalog.memoryBytes() / catalog.size() << " bytes/game (was "
+                  << metadataBytes / catalog.size() << " as GameMetadata)" << std::endl;
+    }
+}
+
+/**
+ * @brief Fetches metadata for a list of games without touching the displayed library.
+ *
+ * Only the IGDB client is used, so this may run on a worker thread while
+ * the menu is up; pass the result to postGameLibrary() afterwards.
+ *
+ * @param games A vector containing game filenames.
+ * @param cancelled If set, checked between games; the fetch then stops early.
+ * @return One record per game, in the same order, or fewer if cancelled.
+ */
+std::vector<GameMetadata> SDLUI::fetchGameMetadata(const std::vector<std::string>& games,
+                                                   const std::atomic<bool>* cancelled) {
+    std::cout << "Loading metadata for " << games.size() << " games..." << std::endl;
+    std::vector<GameMetadata> fetched;
+    fetched.reserve(games.size());
+
+    for (const auto& game : games) {
+        if (cancelled && *cancelled) {
+            break;
+        }
+        try {
+            std::cout << "Processing game: " << game << std::endl;
+            fetched.push_back(igdbClient.fetchGameMetadata(game));
+        } catch (const std::exception& e) {
+            std::cerr << "Error processing game " << game << ": " << e.what() << std::endl;
+            fetched.push_back(basicMetadata(game));
+        }
+    }
+
+    std::cout << "Finished loading metadata for " << fetched.size() << " games" << std::endl;
+    return fetched;
+}
+
+/**
+ * @brief Builds the metadata of a game from its filename alone.
+ *
+ * Used until IGDB answers, and for games it does not know. Without an
+ * image path the game shows the placeholder cover.
+ */
+GameMetadata SDLUI::basicMetadata(const std::string& filename) {
+    GameMetadata basic;
+    basic.filename = filename;
+    basic.title = filename.substr(0, filename.find_last_of('.'));
+    basic.description = "Classic NES game";
+    basic.releaseYear = "Unknown";
+    basic.publisher = "Unknown";
+    basic.genre = "Unknown";
+    return basic;
+}
+
+/**
+ * @brief Renders text onto the screen at a specified position.
+ * @param text The text string to render.
+ * @param x The x-coordinate for rendering.
+ * @param y The y-coordinate for rendering.
+ * @param color The SDL_Color to use for text rendering.
+ */
+void SDLUI::renderText(const std::string& text, int x, int y, const SDL_Color& color) {
+    if (!font) return;
+
+    SDL_Texture* texture = getOrCreateTextTexture(text, color);
+    if (!texture) return;
+
+    int w, h;
+    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+    SDL_Rect dstRect = {x, y, w, h};
+    drawTexture(texture, NULL, &dstRect);
+}
+
+/**
+ * @brief Returns the cached layout of a game description.
+ * @param text The description text.
+ * @param width The available width in pixels.
+ * @param withReadMore Whether a "Read More" link follows the text.
+ * @return The wrapped layout, computed once per text and width.
+ */
+const TextLayout& SDLUI::layoutDescription(const std::string& text, int width, bool withReadMore) {
+    FrameProfiler::Scope scope(profiler, FrameProfiler::Layout);
+    static const std::string readMore = "Read More";
+    return layoutCache.get(text, font, width, MAX_DESCRIPTION_LINES, layout.lineHeight,
+                           withReadMore ? readMore : std::string());
+}
+
+/**
+ * @brief Renders wrapped text within a specified boundary.
+ *
+ * Line breaks come from the layout cache, so steady-state frames only
+ * replay the stored lines and do not measure any text.
+ *
+ * @param text The text string to render.
+ * @param bounds The SDL_Rect specifying the text boundaries.
+ * @param color The SDL_Color to use for text rendering.
+ * @param withReadMore Whether to append a "Read More" link after the text.
+ */
+void SDLUI::renderWrappedText(const std::string& text, const SDL_Rect& bounds, const SDL_Color& color, bool withReadMore) {
+    if (text.empty() || !font) {
+        return;
+    }
+
+    const TextLayout& wrapped = layoutDescription(text, bounds.w, withReadMore);
+
+    int y = bounds.y;
+    for (const auto& line : wrapped.lines) {
+        if (line.length > 0) {
+            renderText(line.text, bounds.x, y, color);
+        }
+        y += layout.lineHeight;
+    }
+
+    if (wrapped.hasLink) {
+        renderText("Read More", bounds.x + wrapped.linkRect.x, bounds.y + wrapped.linkRect.y, linkColor);
+    }
+}
+
+/**
+ * @brief Renders the current view of the game library on the screen.
+ */
+void SDLUI::renderGameList() {
+    beginFrame();
+
+    if (compositor) {
+        collectDamage();
+        SDL_Rect clip = compositor->beginFrame(layout.width, layout.height);
+        if (clip.w <= 0) {
+            // Nothing changed: the window already shows this frame
+            compositor->present(window);
+            profiler.markPresented();
+            endFrame();
+            return;
+        }
+        // SDL_RenderClear ignores the clip rect, so clear only the damage with a fill
+        fillRect(clip, backgroundColor);
+    } else {
+        // Clear the screen
+        SDL_SetRenderDrawColor(renderer, backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
+        SDL_RenderClear(renderer);
+    }
+
+    if (viewMode == ViewMode::Grid) {
+        renderGridView();
+    } else {
+        renderListView();
+    }
+
+    if (!searchQuery.empty()) {
+        renderSearchBar();
+    }
+
+    if (detailOpen) {
+        renderDetailPane();
+    }
+
+    if (showProfiler) {
+        renderProfilerOverlay();
+    }
+
+    if (snapshotPending) {
+        // GPU frames can only be read back before they are presented
+        snapshotPending = false;
+        int width = 0, height = 0;
+        SDL_GetRendererOutputSize(renderer, &width, &height);
+        SDL_Surface* frame = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (frame && SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, frame->pixels, frame->pitch) == 0) {
+            saveSnapshot(frame, width, height);  // Already the size of the view
+        }
+        SDL_FreeSurface(frame);
+    }
+
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::Present);
+        SDL_RenderPresent(renderer);
+        if (compositor) {
+            compositor->present(window);
+        }
+        profiler.markPresented();
+    }
+    endFrame();
+}
+
+/**
+ * @brief Draws the frame-time overlay: phase breakdown, percentiles and a frame graph.
+ *
+ * The text is refreshed four times per second so the overlay does not
+ * rasterize new strings every frame and distort what it measures.
+ */
+void SDLUI::renderProfilerOverlay() {
+    const FrameProfiler::Frame* latest = profiler.latest();
+    if (!latest) return;
+
+    if (latest->start - profilerRefreshTime >= 0.25 || profilerLines.empty()) {
+        profilerRefreshTime = latest->start;
+
+        // Average the breakdown over recent frames so it is readable
+        size_t samples = std::min<size_t>(30, profiler.frameCount());
+        double phases[FrameProfiler::PHASE_COUNT] = {};
+        double work = 0.0;
+        for (size_t n = 0; n < samples; ++n) {
+            const FrameProfiler::Frame& frame = profiler.recent(n);
+            work += frame.workMs;
+            for (int phase = 0; phase < FrameProfiler::PHASE_COUNT; ++phase) {
+                phases[phase] += frame.phaseMs[phase];
+            }
+        }
+
+        char line[160];
+        profilerLines.clear();
+        snprintf(line, sizeof(line), "frame p50 %.1f  p95 %.1f  p99 %.1f ms",
+                 profiler.framePercentile(0.50), profiler.framePercentile(0.95), profiler.framePercentile(0.99));
+        profilerLines.push_back(line);
+        snprintf(line, sizeof(line), "work %.2f ms  (p95 %.1f)  draws %d  switches %d",
+                 work / samples, profiler.workPercentile(0.95), lastFrameStats.drawCalls, lastFrameStats.textureSwitches);
+        profilerLines.push_back(line);
+        snprintf(line, sizeof(line), "prefetch hit %.0f%% of %zu  queued %zu  cancelled %zu",
+                 prefetchStats.hitRate() * 100.0, prefetchStats.arrivals, prefetchStats.requested,
+                 prefetchStats.cancelled);
+        profilerLines.push_back(line);
+        if (profiler.inputLatencyCount() > 0) {
+            snprintf(line, sizeof(line), "input p50 %.1f  p95 %.1f ms  (%zu samples)",
+                     profiler.inputLatencyPercentile(0.50), profiler.inputLatencyPercentile(0.95),
+                     profiler.inputLatencyCount());
+            profilerLines.push_back(line);
+        }
+        // Three phases per line; the last line holds whatever is left
+        const int PHASES_PER_LINE = 3;
+        for (int first = 0; first < FrameProfiler::PHASE_COUNT; first += PHASES_PER_LINE) {
+            std::string text;
+            for (int phase = first; phase < std::min(first + PHASES_PER_LINE, static_cast<int>(FrameProfiler::PHASE_COUNT)); ++phase) {
+                snprintf(line, sizeof(line), "%s%s %.2f", phase == first ? "" : "  ",
+                         FrameProfiler::phaseName(static_cast<FrameProfiler::Phase>(phase)), phases[phase] / samples);
+                text += line;
+            }
+            profilerLines.push_back(text);
+        }
+    }
+
+    const int PANEL_WIDTH = layout.px(380);
+    const int LINE_HEIGHT = layout.px(22);
+    const int GRAPH_HEIGHT = layout.px(60);
+    const float MS_PER_PIXEL = 30.0f / GRAPH_HEIGHT;  // 30 ms fills the graph
+    const int inset = layout.textInset;
+    int x = layout.width - PANEL_WIDTH - layout.margin;
+    int y = layout.margin;
+    int height = static_cast<int>(profilerLines.size()) * LINE_HEIGHT + GRAPH_HEIGHT + 2 * layout.margin;
+
+    profilerPanel = {x, y, PANEL_WIDTH, height};
+    blendRect(profilerPanel, {0, 0, 0, 200});
+
+    for (size_t i = 0; i < profilerLines.size(); ++i) {
+        renderText(profilerLines[i], x + inset, y + inset / 2 + static_cast<int>(i) * LINE_HEIGHT, textColor);
+    }
+
+    // One bar per recent frame, newest on the right, all in a single draw call
+    int graphBottom = y + height - inset;
+    size_t bars = std::min<size_t>(PANEL_WIDTH - 2 * inset, profiler.frameCount());
+    profilerBars.clear();
+    for (size_t n = 0; n < bars; ++n) {
+        int barHeight = std::min(GRAPH_HEIGHT, static_cast<int>(profiler.recent(n).frameMs / MS_PER_PIXEL));
+        profilerBars.push_back({x + PANEL_WIDTH - inset - 1 - static_cast<int>(n), graphBottom - barHeight, 1, barHeight});
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 200, 120, 255);
+    SDL_RenderFillRects(renderer, profilerBars.data(), static_cast<int>(profilerBars.size()));
+    frameStats.drawCalls++;
+
+    // 60 FPS budget line
+    int budgetY = graphBottom - static_cast<int>(16.7f / MS_PER_PIXEL);
+    fillRect({x + inset, budgetY, PANEL_WIDTH - 2 * inset, 1}, errorColor);
+}
+
+/**
+ * @brief Writes the recent frame timings to a CSV file in the working directory.
+ */
+void SDLUI::dumpFrameTimes() {
+    std::string path = "frame_times_" + std::to_string(std::time(nullptr)) + ".csv";
+    if (profiler.dump(path)) {
+        std::cout << "Wrote frame timings to " << path << std::endl;
+    } else {
+        std::cerr << "Failed to write frame timings to " << path << std::endl;
+    }
+}
+
+/**
+ * @brief Renders the visible rows of the detailed list view.
+ *
+ * Only rows intersecting the window are visited, so the cost of a frame
+ * does not depend on the size of the library. Each row's background and
+ * text come from a cached render target, so a steady-state row is one
+ * copy plus its batched cover.
+ */
+void SDLUI::renderListView() {
+    const int pitch = layout.itemPitch;
+    const int count = rowCount();
+    const int scrollY = static_cast<int>(listScroll.getPosition());
+    int first = std::max(0, scrollY / pitch);
+    int last = std::min(count - 1, (scrollY + layout.height) / pitch);
+
+    for (int i = first; i <= last; ++i) {
+        const GameId game = gameAtRow(i);
+        const bool selected = i == selectedIndex;
+        int y = layout.itemPadding + i * pitch - scrollY;
+        SDL_Rect rowRect = {0, y - layout.selectionInset, layout.width,
+                            layout.itemHeight + 2 * layout.selectionInset};
+
+        if (SDL_Texture* row = getOrCreateRowTexture(game, selected, rowRect.w, rowRect.h)) {
+            drawTexture(row, NULL, &rowRect);
+        } else {
+            // No render targets: draw the row directly every frame
+            if (selected) {
+                fillRect(rowRect, selectedColor);
+            }
+            renderRowContents(game, y);
+        }
+
+        // Queue the cover (or its preview, or the placeholder) for the batched atlas draw
+        SDL_Rect coverRect = {layout.itemPadding, y, layout.coverSize, layout.coverSize};
+        queueGameCover(game, coverRect);
+    }
+
+    // Covers never overlap text, so all of them go out in one batch at the end
+    flushCovers();
+}
+
+/**
+ * @brief Draws the title, details line and description of a list row.
+ * @param game The game shown in the row.
+ * @param y Top of the row's text in the current render target.
+ */
+void SDLUI::renderRowContents(GameId game, int y) {
+    renderText(catalog.title(game), layout.textX, y, textColor);
+    renderText(catalog.details(game), layout.textX, y + layout.detailsY, textColor);
+
+    // Render description with Read More link only if game is found in IGDB
+    SDL_Rect descBounds = {layout.textX, y + layout.descriptionY, layout.descriptionWidth, layout.descriptionHeight};
+    renderWrappedText(catalog.description(game), descBounds, textColor, catalog.hasIgdbUrl(game));
+}
+
+/**
+ * @brief Returns a list row composited into a texture, rendering it on first use.
+ *
+ * Rows are opaque (filled with the background or selection color), so
+ * they are copied without blending. Entries are keyed by game and
+ * selection state; a layout or font change clears the whole cache.
+ *
+ * @param game The game shown in the row.
+ * @param selected Whether the row is highlighted.
+ * @param width Width of the row in pixels.
+ * @param height Height of the row including the selection inset.
+ * @return The row texture, or nullptr if render targets are unavailable.
+ */
+SDL_Texture* SDLUI::getOrCreateRowTexture(GameId game, bool selected, int width, int height) {
+    // Short enough for the small-string buffer, so hits do not allocate
+    std::string key = std::to_string(game);
+    if (selected) {
+        key += '*';
+    }
+    if (SDL_Texture* cached = rowTextureCache.get(key)) {
+        return cached;
+    }
+    if (!rowTargetsSupported || !font) {
+        return nullptr;
+    }
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+        std::cerr << "Failed to create row texture, drawing rows directly! SDL Error: " << SDL_GetError() << std::endl;
+        rowTargetsSupported = false;
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, texture) != 0) {
+        std::cerr << "Failed to render into row texture! SDL Error: " << SDL_GetError() << std::endl;
+        SDL_DestroyTexture(texture);
+        rowTargetsSupported = false;
+        return nullptr;
+    }
+
+    const SDL_Color& fill = selected ? selectedColor : backgroundColor;
+    SDL_SetRenderDrawColor(renderer, fill.r, fill.g, fill.b, fill.a);
+    SDL_RenderClear(renderer);
+    renderRowContents(game, layout.selectionInset);
+
+    SDL_SetRenderTarget(renderer, previous);
+    lastDrawnTexture = nullptr;
+    rowTextureCache.put(key, texture);
+    return texture;
+}
+
+/**
+ * @brief Returns the geometry of the cover grid at the current zoom.
+ */
+SDLUI::GridMetrics SDLUI::getGridMetrics() const {
+    // Only a zoom step or a layout change produces a new tile size
+    int tileSize = std::max(1, layout.px(gridTileSize));
+    if (tileSize == gridMetricsTile) {
+        return gridMetrics;
+    }
+
+    GridMetrics& grid = gridMetrics;
+    grid.tileSize = tileSize;
+    grid.pitch = grid.tileSize + layout.gridGap;
+    grid.columns = std::max(1, (layout.width - layout.gridGap) / grid.pitch);
+    grid.offsetX = std::max(0, (layout.width - grid.columns * grid.pitch + layout.gridGap) / 2);
+    grid.viewHeight = layout.gridViewHeight;
+    gridMetricsTile = tileSize;
+    return grid;
+}
+
+/**
+ * @brief Renders the cover wall: only the visible tiles, plus a status bar.
+ *
+ * Every tile is a quad in one of the thumbnail atlases, so a screen full
+ * of hundreds of covers costs a handful of geometry submissions.
+ */
+void SDLUI::renderGridView() {
+    const GridMetrics grid = getGridMetrics();
+    const int count = rowCount();
+    const int scrollY = static_cast<int>(gridScroll.getPosition());
+    int firstRow = std::max(0, scrollY / grid.pitch);
+    int lastRow = (scrollY + grid.viewHeight) / grid.pitch;
+
+    // Highlight goes underneath the covers
+    if (selectedIndex >= 0 && selectedIndex < count) {
+        int row = selectedIndex / grid.columns;
+        int col = selectedIndex % grid.columns;
+        const int border = layout.px(4);
+        SDL_Rect highlight = {grid.offsetX + col * grid.pitch - border,
+                              layout.gridGap + row * grid.pitch - scrollY - border,
+                              grid.tileSize + 2 * border, grid.tileSize + 2 * border};
+        fillRect(highlight, linkColor);
+    }
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        int y = layout.gridGap + row * grid.pitch - scrollY;
+        for (int col = 0; col < grid.columns; ++col) {
+            int i = row * grid.columns + col;
+            if (i >= count) break;
+
+            SDL_Rect tile = {grid.offsetX + col * grid.pitch, y, grid.tileSize, grid.tileSize};
+            queueGameCover(gameAtRow(i), tile);
+        }
+    }
+    flushCovers();
+
+    // Status bar with the selected title
+    SDL_Rect status = {0, grid.viewHeight, layout.width, layout.statusHeight};
+    fillRect(status, selectedColor);
+    if (selectedIndex >= 0 && selectedIndex < count) {
+        const int textY = grid.viewHeight + layout.px(10);
+        renderText(catalog.title(gameAtRow(selectedIndex)), layout.itemPadding, textY, textColor);
+        std::string position = std::to_string(selectedIndex + 1) + " / " + std::to_string(count);
+        renderText(position, layout.width - layout.px(140), textY, textColor);
+    }
+}
+
+/**
+ * @brief Draws the query and its match count along the bottom of the view.
+ */
+void SDLUI::renderSearchBar() {
+    int y = layout.height - layout.searchBarHeight;
+    if (viewMode == ViewMode::Grid) {
+        y = layout.gridViewHeight - layout.searchBarHeight;  // Sit above the status bar
+    }
+
+    SDL_Rect bar = {0, y, layout.width, layout.searchBarHeight};
+    fillRect(bar, selectedColor);
+    renderText("Search: " + searchQuery + "_", layout.itemPadding, y + layout.textInset, textColor);
+
+    std::string matches = visibleRows.empty() ? "No matches"
+                                              : std::to_string(visibleRows.size()) + " matches";
+    renderText(matches, layout.width - layout.px(160), y + layout.textInset,
+               visibleRows.empty() ? errorColor : textColor);
+}
+
+/**
+ * @brief Draws the detail pane of detailGame over the current view.
+ *
+ * The cover, title, details line and full description come from the
+ * catalog and show at once. The rating, storyline, thumbnails and similar
+ * games fill in when the DetailLoader has fetched them.
+ */
+void SDLUI::renderDetailPane() {
+    const SDL_Rect panel = {layout.detailX, layout.detailY, layout.detailWidth, layout.detailHeight};
+    blendRect({0, 0, layout.width, layout.height}, {0, 0, 0, 160});
+    fillRect(panel, selectedColor);
+
+    const int pad = layout.itemPadding;
+    const int line = layout.lineHeight;
+    const int left = panel.x + pad;
+    const int right = panel.x + panel.w - pad;
+    const int textX = left + layout.detailCoverSize + pad;
+    const int textWidth = std::max(1, right - textX);
+
+    const std::string& url = catalog.igdbUrl(detailGame);
+    const GameDetails* details = url.empty() ? nullptr : detailLoader.find(url);
+
+    const SDL_Rect cover = {left, panel.y + pad, layout.detailCoverSize, layout.detailCoverSize};
+    queueGameCover(detailGame, cover);
+
+    int y = cover.y;
+    renderText(catalog.title(detailGame), textX, y, textColor);
+    y += line;
+    renderText(catalog.details(detailGame), textX, y, textColor);
+    y += line;
+
+    std::string status;
+    SDL_Color statusColor = textColor;
+    if (url.empty()) {
+        status = "Not found in IGDB";
+    } else if (details) {
+        if (details->rating >= 0) {
+            char rating[64];
+            snprintf(rating, sizeof(rating), "Rating %d/100 from %d ratings", details->rating, details->ratingCount);
+            status = rating;
+        }
+    } else if (detailLoader.getState(url) == DetailLoader::State::Failed) {
+        status = "Details unavailable";
+        statusColor = errorColor;
+    } else {
+        status = "Loading details...";
+    }
+    if (!status.empty()) {
+        renderText(status, textX, y, statusColor);
+        y += line;
+    }
+    y += line / 2;
+
+    // The bottom is filled upwards: key hints, thumbnails, similar games
+    int limit = panel.y + panel.h - pad - line;
+    renderText("Enter: play    Esc: back", left, limit, linkColor);
+    limit -= pad / 2;
+
+    const int coverBottom = cover.y + cover.h + pad / 2;
+    if (details) {
+        const int thumb = layout.detailThumbSize;
+        if (!details->screenshots.empty() || !details->artworks.empty()) {
+            if (limit - thumb >= coverBottom) {
+                int x = left;
+                for (const std::vector<std::string>* paths : {&details->screenshots, &details->artworks}) {
+                    for (const std::string& path : *paths) {
+                        if (x + thumb > right) break;
+                        queueCoverDraw(path, {x, limit - thumb, thumb, thumb});
+                        x += thumb + layout.gridGap;
+                    }
+                }
+                limit -= thumb + pad / 2;
+            }
+        }
+
+        if (!details->similarGames.empty() && limit - 2 * line >= coverBottom) {
+            std::string similar = "Similar: ";
+            for (size_t i = 0; i < details->similarGames.size(); ++i) {
+                similar += (i > 0 ? ", " : "") + details->similarGames[i];
+            }
+            limit -= 2 * line;
+            renderParagraph(similar, left, limit, right - left, 2, textColor);
+            limit -= pad / 2;
+        }
+    }
+
+    // Description and storyline take the rest of the column beside the cover
+    y = renderParagraph(catalog.description(detailGame), textX, y, textWidth, std::max(0, (limit - y) / line), textColor);
+    if (details && !details->storyline.empty()) {
+        y += line / 2;
+        renderParagraph(details->storyline, textX, y, textWidth, std::max(0, (limit - y) / line), textColor);
+    }
+
+    flushCovers();
+}
+
+/**
+ * @brief Draws a paragraph wrapped to a width, up to a number of lines.
+ * @return The y just below the last line drawn.
+ */
+int SDLUI::renderParagraph(const std::string& text, int x, int y, int width, int maxLines, const SDL_Color& color) {
+    if (text.empty() || !font || maxLines <= 0) {
+        return y;
+    }
+
+    const TextLayout* wrapped;
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::Layout);
+        wrapped = &layoutCache.get(text, font, width, maxLines, layout.lineHeight, std::string());
+    }
+    for (const TextLine& line : wrapped->lines) {
+        if (line.length > 0) {
+            renderText(line.text, x, y, color);
+        }
+        y += layout.lineHeight;
+    }
+    return y;
+}
+
+/**
+ * @brief Summarizes which level (or preview) each image of the detail pane would be drawn from.
+ *
+ * The value changes whenever one of them streams in, which is when the
+ * software renderer has to redraw the pane.
+ */
+unsigned int SDLUI::detailImageSignature() const {
+    unsigned int signature = 0;
+    auto add = [&](const std::string& path, int pixels) {
+        if (!path.empty()) {
+            signature = signature * 6 + static_cast<unsigned int>(residentCoverLevel(path, coverLevelFor(pixels)) + 1);
+        }
+    };
+
+    signature = static_cast<unsigned int>(coverSource(detailGame, coverLevelFor(layout.detailCoverSize)) + 1);
+    const std::string& url = catalog.igdbUrl(detailGame);
+    if (const GameDetails* details = url.empty() ? nullptr : detailLoader.find(url)) {
+        for (const std::vector<std::string>* paths : {&details->screenshots, &details->artworks}) {
+            for (const std::string& path : *paths) {
+                add(path, layout.detailThumbSize);
+            }
+        }
+    }
+    return signature;
+}
+
+/**
+ * @brief Advances animations by the elapsed frame time.
+ *
+ * Held-key repeats, scroll easing, flings and zoom are all integrated
+ * from dt, so motion keeps its speed when a frame runs long. A library
+ * posted from another thread is installed first.
+ *
+ * @param dt Seconds since the previous frame.
+ */
+void SDLUI::update(float dt) {
+    applyPendingLibrary();
+
+    int steps = navRepeater.update(dt);
+    if (steps > 0) {
+        // A repeat step changes the frame just like a key press would
+        profiler.markInput();
+        moveSelection(steps * heldStride);
+    }
+    updateStick(dt);
+
+    // Ease the zoom towards its target independently of the frame rate
+    if (gridTileSize != gridTileTarget) {
+        const float ZOOM_RATE = 14.0f;
+        gridTileSize += (gridTileTarget - gridTileSize) * (1.0f - std::exp(-ZOOM_RATE * dt));
+        if (std::fabs(gridTileTarget - gridTileSize) < 0.5f) {
+            gridTileSize = gridTileTarget;
+        }
+        updateScrollBounds();
+        ensureSelectionVisible();
+    }
+
+    listScroll.update(dt);
+    gridScroll.update(dt);
+    prefetch(dt);
+    updateDwell(dt);
+}
+
+/**
+ * @brief Sets the callback told when the selection rests on a game and when it moves on.
+ * @param callback Receives the library index, or -1; runs on the UI thread and must not block.
+ * @param seconds How long the selection must stay put.
+ */
+void SDLUI::setDwellCallback(DwellCallback callback, float seconds) {
+    dwellCallback = std::move(callback);
+    dwellSeconds = seconds;
+    dwellGame = -1;
+    dwellFired = false;
+}
+
+/**
+ * @brief Times how long the selection has rested and reports it to the dwell callback.
+ *
+ * Scrolling past games with a held key changes the selection every few
+ * frames, so only a selection that stays put for dwellSeconds is reported.
+ *
+ * @param dt Seconds since the previous frame.
+ */
+void SDLUI::updateDwell(float dt) {
+    if (!dwellCallback) return;
+
+    const bool valid = selectedIndex >= 0 && selectedIndex < static_cast<int>(visibleRows.size());
+    const int game = valid ? static_cast<int>(visibleRows[selectedIndex]) : -1;
+    if (game != dwellGame) {
+        if (dwellFired) {
+            dwellCallback(-1);
+        }
+        dwellGame = game;
+        dwellElapsed = 0.0f;
+        dwellFired = false;
+        return;
+    }
+
+    if (!dwellFired && game >= 0) {
+        dwellElapsed += dt;
+        if (dwellElapsed >= dwellSeconds) {
+            dwellFired = true;
+            dwellCallback(game);
+        }
+    }
+}
+
+/**
+ * @brief Requests covers and wraps descriptions for rows about to scroll into view.
+ *
+ * The predicted window follows the scroll velocity and the animation's
+ * resting position. When it moves, queued decodes that fell out of both
+ * the view and the window are cancelled and covers ahead of the motion are
+ * queued nearest first, behind anything visible. Rows entering the view
+ * are counted as prefetch hits when their cover is already resident.
+ *
+ * @param dt Seconds since the previous frame.
+ */
+void SDLUI::prefetch(float dt) {
+    const int PREFETCH_LAYOUTS_PER_FRAME = 2;
+
+    const bool grid = viewMode == ViewMode::Grid;
+    const GridMetrics metrics = getGridMetrics();
+    const int pitch = grid ? metrics.pitch : layout.itemPitch;
+    const int columns = grid ? metrics.columns : 1;
+    const float viewHeight = static_cast<float>(grid ? metrics.viewHeight : layout.height);
+    const int level = coverLevelFor(grid ? metrics.tileSize : layout.coverSize);
+    const ScrollAnimator& scroll = activeScroll();
+    const float position = scroll.getPosition();
+
+    // A search, view switch or zoom step puts different items at each position
+    bool reset = prefetchReset || pitch != prefetchPitch || columns != prefetchColumns;
+    if (reset) {
+        scrollPredictor.reset(position);
+        prefetchReset = false;
+        prefetchPitch = pitch;
+        prefetchColumns = columns;
+        predictedFirst = 0;
+        predictedLast = -1;
+    } else {
+        scrollPredictor.update(position, scroll.getRestingPosition(), viewHeight, dt);
+    }
+
+    int first, last;
+    itemsInSpan(position, position + viewHeight, pitch, columns, first, last);
+    if (!reset) {
+        for (int i = first; i <= last; ++i) {
+            if (i >= visibleFirst && i <= visibleLast) continue;
+            const std::string& path = catalog.imagePath(gameAtRow(i));
+            if (path.empty() || failedImages.count(path)) continue;
+            prefetchStats.arrivals++;
+            if (coverLevels[level]->contains(path)) {
+                prefetchStats.readyOnArrival++;
+            }
+        }
+    }
+    visibleFirst = first;
+    visibleLast = last;
+
+    float top, bottom;
+    scrollPredictor.predict(viewHeight, top, bottom);
+    int aheadFirst, aheadLast;
+    itemsInSpan(top, bottom, pitch, columns, aheadFirst, aheadLast);
+    aheadFirst = std::min(aheadFirst, first);
+    aheadLast = std::max(aheadLast, last);
+    const bool down = scrollPredictor.getVelocity() >= 0.0f;
+
+    if (aheadFirst != predictedFirst || aheadLast != predictedLast || level != prefetchLevel) {
+        predictedFirst = aheadFirst;
+        predictedLast = aheadLast;
+        prefetchLevel = level;
+
+        // Catalog paths are interned, so views of them stay valid while the window is in use
+        if (imageLoader.pendingCount() > 0) {
+            prefetchKeep.clear();
+            for (int i = aheadFirst; i <= aheadLast; ++i) {
+                prefetchKeep.insert(catalog.imagePath(gameAtRow(i)));
+            }
+            const int size = COVER_LEVEL_SIZES[level];
+            // Covers on screen, the detail pane and the resume hold asked for theirs; only guesses go
+            prefetchStats.cancelled += imageLoader.cancelQueued([&](const std::string& path, int requested, bool prefetch) {
+                return !prefetch || (requested == size && prefetchKeep.count(path) != 0);
+            });
+        }
+
+        // Ahead of the motion first, then the margin behind it
+        if (down) {
+            for (int i = last + 1; i <= aheadLast; ++i) prefetchCover(i, level);
+            for (int i = first - 1; i >= aheadFirst; --i) prefetchCover(i, level);
+        } else {
+            for (int i = first - 1; i >= aheadFirst; --i) prefetchCover(i, level);
+            for (int i = last + 1; i <= aheadLast; ++i) prefetchCover(i, level);
+        }
+    }
+
+    // Wrap a few upcoming descriptions per frame so rows arrive with their text measured
+    if (!grid) {
+        int warmed = 0;
+        const int step = down ? 1 : -1;
+        for (int i = down ? last + 1 : first - 1;
+             i >= aheadFirst && i <= aheadLast && warmed < PREFETCH_LAYOUTS_PER_FRAME; i += step) {
+            const GameId game = gameAtRow(i);
+            size_t computed = layoutCache.getComputeCount();
+            layoutDescription(catalog.description(game), layout.descriptionWidth, catalog.hasIgdbUrl(game));
+            if (layoutCache.getComputeCount() != computed) {
+                warmed++;
+            }
+        }
+        prefetchStats.layoutsWarmed += warmed;
+    }
+}
+
+/**
+ * @brief Returns the items of the active view that intersect a span of content offsets.
+ *
+ * @param top First content offset of the span.
+ * @param bottom Last content offset of the span.
+ * @param pitch Height of one row of items.
+ * @param columns Items per row.
+ * @param first Receives the first item.
+ * @param last Receives the last item; less than first if the span holds none.
+ */
+void SDLUI::itemsInSpan(float top, float bottom, int pitch, int columns, int& first, int& last) const {
+    int firstRow = std::max(0, static_cast<int>(std::floor(top / pitch)));
+    int lastRow = static_cast<int>(std::floor(bottom / pitch));
+    first = firstRow * columns;
+    last = std::min(rowCount() - 1, (lastRow + 1) * columns - 1);
+}
+
+/**
+ * @brief Queues a background decode for an item's cover unless it is resident or failed.
+ * @return true if a decode was newly queued.
+ */
+bool SDLUI::prefetchCover(int item, int level) {
+    const std::string& path = catalog.imagePath(gameAtRow(item));
+    if (path.empty() || coverLevels[level]->contains(path) || failedImages.count(path) || coverDeferred(path, level)) {
+        return false;
+    }
+    if (!imageLoader.request(path, COVER_LEVEL_SIZES[level], true)) {
+        return false;
+    }
+    prefetchStats.requested++;
+    return true;
+}
+
+/**
+ * @brief Turns the left stick's deflection into selection steps.
+ *
+ * The stick scrolls at a rate proportional to its shaped deflection, so a
+ * slight push creeps row by row and full deflection races through the list.
+ * Fractional steps carry over between frames.
+ *
+ * @param dt Seconds since the previous frame.
+ */
+void SDLUI::updateStick(float dt) {
+    const float STICK_MAX_STEPS_PER_SECOND = 25.0f;
+
+    if (stickX == 0.0f && stickY == 0.0f) {
+        stickStepsX = stickStepsY = 0.0f;
+        return;
+    }
+
+    const bool grid = viewMode == ViewMode::Grid;
+    stickStepsY += stickY * STICK_MAX_STEPS_PER_SECOND * dt;
+    stickStepsX = grid ? stickStepsX + stickX * STICK_MAX_STEPS_PER_SECOND * dt : 0.0f;
+
+    int rows = static_cast<int>(stickStepsY);
+    int columns = static_cast<int>(stickStepsX);
+    stickStepsY -= rows;
+    stickStepsX -= columns;
+    if (rows != 0 || columns != 0) {
+        moveSelection(rows * (grid ? getGridMetrics().columns : 1) + columns);
+    }
+}
+
+/**
+ * @brief Moves the selection by delta entries, clamped to the library.
+ */
+void SDLUI::moveSelection(int delta) {
+    if (visibleRows.empty() || detailOpen) return;
+    selectedIndex = std::clamp(selectedIndex + delta, 0, rowCount() - 1);
+    ensureSelectionVisible();
+}
+
+/**
+ * @brief Returns the scroll animator of the current view.
+ */
+ScrollAnimator& SDLUI::activeScroll() {
+    return viewMode == ViewMode::Grid ? gridScroll : listScroll;
+}
+
+/**
+ * @brief Starts an animated scroll that brings the selected entry into view.
+ *
+ * Visibility is judged against where the scroll will come to rest, so
+ * several quick key presses extend one smooth motion instead of
+ * restarting it from a mid-animation position.
+ */
+void SDLUI::ensureSelectionVisible() {
+    if (selectedIndex < 0) return;
+
+    float top, bottom, viewHeight;
+    if (viewMode == ViewMode::Grid) {
+        GridMetrics grid = getGridMetrics();
+        top = static_cast<float>((selectedIndex / grid.columns) * grid.pitch);
+        bottom = top + grid.pitch + layout.gridGap;
+        viewHeight = static_cast<float>(grid.viewHeight);
+    } else {
+        const int pitch = layout.itemPitch;
+        top = static_cast<float>(selectedIndex * pitch);
+        bottom = top + pitch + layout.itemPadding;
+        viewHeight = static_cast<float>(layout.height);
+    }
+
+    ScrollAnimator& scroll = activeScroll();
+    float resting = scroll.getRestingPosition();
+    if (top < resting) {
+        scroll.scrollTo(top);
+    } else if (bottom > resting + viewHeight) {
+        scroll.scrollTo(bottom - viewHeight);
+    }
+}
+
+/**
+ * @brief Updates the scroll range of both views from the library size and zoom.
+ */
+void SDLUI::updateScrollBounds() {
+    const int count = rowCount();
+
+    GridMetrics grid = getGridMetrics();
+    int rows = (count + grid.columns - 1) / grid.columns;
+    gridScroll.setBounds(0.0f, static_cast<float>(rows * grid.pitch + layout.gridGap - grid.viewHeight));
+
+    const int pitch = layout.itemPitch;
+    listScroll.setBounds(0.0f, static_cast<float>(count * pitch + layout.itemPadding - layout.height));
+}
+
+/**
+ * @brief Handles user input, such as keyboard and mouse events.
+ */
+void SDLUI::handleInput() {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        // Input-to-present latency starts at the event's timestamp, not when it is polled.
+        // OS key repeats are not user input: held keys repeat through navRepeater, marked in update()
+        switch (event.type) {
+            case SDL_KEYDOWN:
+                if (!event.key.repeat) {
+                    profiler.markInput((SDL_GetTicks() - event.common.timestamp) / 1000.0);
+                }
+                break;
+            case SDL_TEXTINPUT:
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEWHEEL:
+            case SDL_FINGERDOWN:
+            case SDL_FINGERMOTION:
+            case SDL_CONTROLLERBUTTONDOWN:
+                profiler.markInput((SDL_GetTicks() - event.common.timestamp) / 1000.0);
+                break;
+        }
+
+        switch (event.type) {
+            case SDL_QUIT:
+                selectedIndex = -1;  // Signal to exit
+                return;
+
+            case SDL_WINDOWEVENT:
+                if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+                    event.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED) {
+                    updateLayout();
+                } else if (event.window.event == SDL_WINDOWEVENT_EXPOSED && compositor) {
+                    compositor->invalidateAll();  // The window system lost our pixels
+                }
+                break;
+
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                rowTextureCache.clear();  // Render target contents are undefined after a reset
+                break;
+                
+            case SDL_KEYDOWN:
+                handleKeyDown(event.key);
+                if (gameSelected || selectedIndex == -1) return;
+                break;
+
+            case SDL_TEXTINPUT:
+                handleTextInput(event.text.text);
+                break;
+
+            case SDL_KEYUP:
+                if (event.key.keysym.sym == heldKey) {
+                    navRepeater.release();
+                    heldKey = SDLK_UNKNOWN;
+                }
+                break;
+
+            case SDL_MOUSEWHEEL:
+                if (detailOpen) {
+                    break;  // The view behind the pane stays put
+                }
+                if (viewMode == ViewMode::Grid && (SDL_GetModState() & KMOD_CTRL)) {
+                    float factor = event.wheel.y > 0 ? 1.25f : 1.0f / 1.25f;
+                    gridTileTarget = std::clamp(gridTileTarget * factor,
+                                                static_cast<float>(GRID_MIN_TILE_SIZE),
+                                                static_cast<float>(GRID_MAX_TILE_SIZE));
+                } else {
+                    // Each notch adds momentum, so fast wheel spins coast further
+                    const float WHEEL_IMPULSE = 900.0f;
+                    activeScroll().fling(-event.wheel.y * WHEEL_IMPULSE * layout.scale);
+                }
+                break;
+
+            case SDL_FINGERDOWN:
+            case SDL_FINGERMOTION:
+            case SDL_FINGERUP:
+                handleTouch(event.tfinger);
+                break;
+
+            case SDL_CONTROLLERDEVICEADDED:
+                openController(event.cdevice.which);
+                break;
+
+            case SDL_CONTROLLERDEVICEREMOVED:
+                closeController(event.cdevice.which);
+                break;
+
+            case SDL_CONTROLLERBUTTONDOWN:
+                handleControllerButton(event.cbutton);
+                if (gameSelected || selectedIndex == -1) return;
+                break;
+
+            case SDL_CONTROLLERBUTTONUP:
+                if (event.cbutton.button == heldButton) {
+                    navRepeater.release();
+                    heldButton = SDL_CONTROLLER_BUTTON_INVALID;
+                }
+                break;
+
+            case SDL_CONTROLLERAXISMOTION:
+                handleControllerAxis(event.caxis);
+                break;
+                
+            case SDL_MOUSEBUTTONDOWN:
+                if (event.button.button == SDL_BUTTON_LEFT) {
+                    // Mouse coordinates are in window points; layout is in drawable pixels
+                    handleClick(static_cast<int>(event.button.x * layout.pixelRatio),
+                                static_cast<int>(event.button.y * layout.pixelRatio));
+                    if (gameSelected) return;
+                }
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Handles a key press.
+ *
+ * Navigation keys move once on press and then repeat on the hold curve
+ * from update(); the OS key repeat is ignored so the rate does not depend
+ * on desktop settings or the frame rate. Space, or Right in the list,
+ * opens the detail pane, which then takes the keys until it is closed.
+ *
+ * @param key The keyboard event.
+ */
+void SDLUI::handleKeyDown(const SDL_KeyboardEvent& key) {
+    const bool grid = viewMode == ViewMode::Grid;
+    const int columns = grid ? getGridMetrics().columns : 1;
+    const SDL_Keycode sym = key.keysym.sym;
+
+    // The detail pane takes the keys until it is closed
+    if (detailOpen) {
+        switch (sym) {
+            case SDLK_ESCAPE:
+            case SDLK_LEFT:
+            case SDLK_BACKSPACE:
+                closeDetails();
+                break;
+            case SDLK_RETURN:
+                confirmSelection();
+                break;
+            case SDLK_F11:
+                toggleFullscreen();
+                break;
+        }
+        return;
+    }
+
+    // Ctrl+letter or digit jumps to the next title with that initial
+    if ((key.keysym.mod & KMOD_CTRL) &&
+        ((sym >= SDLK_a && sym <= SDLK_z) || (sym >= SDLK_0 && sym <= SDLK_9))) {
+        jumpToInitial(static_cast<char>(sym));
+        return;
+    }
+
+    int stride = 0;
+    switch (sym) {
+        case SDLK_UP:
+            stride = -columns;
+            break;
+        case SDLK_DOWN:
+            stride = columns;
+            break;
+        case SDLK_LEFT:
+            stride = grid ? -1 : 0;
+            break;
+        case SDLK_RIGHT:
+            if (grid) {
+                stride = 1;
+            } else {
+                openDetails();
+            }
+            break;
+        case SDLK_PAGEUP:
+            stride = -pageStride();
+            break;
+        case SDLK_PAGEDOWN:
+            stride = pageStride();
+            break;
+        case SDLK_SPACE:
+            // While a query is being typed a space belongs to it
+            if (searchQuery.empty()) {
+                openDetails();
+            }
+            break;
+        case SDLK_TAB:
+            toggleView();
+            break;
+        case SDLK_PLUS:
+        case SDLK_EQUALS:
+        case SDLK_KP_PLUS:
+            // While a query is being typed these characters belong to it
+            if (searchQuery.empty()) {
+                gridTileTarget = std::min<float>(GRID_MAX_TILE_SIZE, gridTileTarget * 1.25f);
+            }
+            break;
+        case SDLK_MINUS:
+        case SDLK_KP_MINUS:
+            if (searchQuery.empty()) {
+                gridTileTarget = std::max<float>(GRID_MIN_TILE_SIZE, gridTileTarget / 1.25f);
+            }
+            break;
+        case SDLK_BACKSPACE:
+            if (!searchQuery.empty()) {
+                // Drop a whole UTF-8 character, continuation bytes first
+                while (searchQuery.size() > 1 && (searchQuery.back() & 0xC0) == 0x80) {
+                    searchQuery.pop_back();
+                }
+                searchQuery.pop_back();
+                applySearch();
+            }
+            break;
+        case SDLK_F3:
+            showProfiler = !showProfiler;
+            break;
+        case SDLK_F4:
+            dumpFrameTimes();
+            break;
+        case SDLK_F11:
+            toggleFullscreen();
+            break;
+        case SDLK_RETURN:
+            confirmSelection();
+            break;
+        case SDLK_ESCAPE:
+            goBack();
+            break;
+    }
+
+    if (stride != 0 && !key.repeat) {
+        navRepeater.setCurve(keyRepeatCurve);
+        heldKey = sym;
+        heldButton = SDL_CONTROLLER_BUTTON_INVALID;
+        startHold(stride);
+    }
+}
+
+/**
+ * @brief Handles a game controller button press.
+ *
+ * The d-pad moves like the arrow keys and the shoulders page; both repeat
+ * on the controller's hold curve. A and Start launch, B backs out of the
+ * search and then the launcher, X switches views, Y (or right in the list)
+ * opens the detail pane and Back toggles the profiler overlay. While the
+ * pane is open only launching and closing it do anything.
+ *
+ * @param button The controller button event.
+ */
+void SDLUI::handleControllerButton(const SDL_ControllerButtonEvent& button) {
+    const bool grid = viewMode == ViewMode::Grid;
+    const int columns = grid ? getGridMetrics().columns : 1;
+
+    if (detailOpen) {
+        switch (button.button) {
+            case SDL_CONTROLLER_BUTTON_B:
+            case SDL_CONTROLLER_BUTTON_Y:
+            case SDL_CONTROLLER_BUTTON_DPAD_LEFT:
+                closeDetails();
+                break;
+            case SDL_CONTROLLER_BUTTON_A:
+            case SDL_CONTROLLER_BUTTON_START:
+                confirmSelection();
+                break;
+        }
+        return;
+    }
+
+    int stride = 0;
+    switch (button.button) {
+        case SDL_CONTROLLER_BUTTON_DPAD_UP:
+            stride = -columns;
+            break;
+        case SDL_CONTROLLER_BUTTON_DPAD_DOWN:
+            stride = columns;
+            break;
+        case SDL_CONTROLLER_BUTTON_DPAD_LEFT:
+            stride = grid ? -1 : 0;
+            break;
+        case SDL_CONTROLLER_BUTTON_DPAD_RIGHT:
+            if (grid) {
+                stride = 1;
+            } else {
+                openDetails();
+            }
+            break;
+        case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+            stride = -pageStride();
+            break;
+        case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER:
+            stride = pageStride();
+            break;
+        case SDL_CONTROLLER_BUTTON_A:
+        case SDL_CONTROLLER_BUTTON_START:
+            confirmSelection();
+            break;
+        case SDL_CONTROLLER_BUTTON_B:
+            goBack();
+            break;
+        case SDL_CONTROLLER_BUTTON_X:
+            toggleView();
+            break;
+        case SDL_CONTROLLER_BUTTON_Y:
+            openDetails();
+            break;
+        case SDL_CONTROLLER_BUTTON_BACK:
+            showProfiler = !showProfiler;
+            break;
+    }
+
+    if (stride != 0) {
+        navRepeater.setCurve(padRepeatCurve);
+        heldButton = static_cast<SDL_GameControllerButton>(button.button);
+        heldKey = SDLK_UNKNOWN;
+        startHold(stride);
+    }
+}
+
+/**
+ * @brief Tracks the left stick, removing the dead zone and shaping the response.
+ *
+ * Deflection is squared after the dead zone so small movements give fine
+ * control while the full range still reaches the maximum speed.
+ *
+ * @param axis The controller axis event.
+ */
+void SDLUI::handleControllerAxis(const SDL_ControllerAxisEvent& axis) {
+    const float DEAD_ZONE = 0.2f;
+    if (axis.axis != SDL_CONTROLLER_AXIS_LEFTX && axis.axis != SDL_CONTROLLER_AXIS_LEFTY) {
+        return;
+    }
+
+    float raw = std::max(-1.0f, axis.value / 32767.0f);
+    float magnitude = std::max(0.0f, (std::fabs(raw) - DEAD_ZONE) / (1.0f - DEAD_ZONE));
+    float shaped = std::copysign(magnitude * magnitude, raw);
+
+    float& target = axis.axis == SDL_CONTROLLER_AXIS_LEFTX ? stickX : stickY;
+    if (target == 0.0f && shaped != 0.0f) {
+        // Leaving the dead zone is the user input; later motion only adjusts speed
+        profiler.markInput((SDL_GetTicks() - axis.timestamp) / 1000.0);
+    }
+    target = shaped;
+}
+
+/**
+ * @brief Opens a newly connected game controller.
+ * @param deviceIndex Joystick device index from SDL_CONTROLLERDEVICEADDED.
+ */
+void SDLUI::openController(int deviceIndex) {
+    SDL_GameController* controller = SDL_GameControllerOpen(deviceIndex);
+    if (!controller) {
+        std::cerr << "Could not open game controller " << deviceIndex << ": " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller));
+    if (controllers.count(id)) {
+        SDL_GameControllerClose(controller);  // Already open; SDL holds a reference per open
+        return;
+    }
+    controllers[id] = controller;
+    const char* name = SDL_GameControllerName(controller);
+    std::cout << "Controller connected: " << (name ? name : "unknown") << std::endl;
+}
+
+/**
+ * @brief Closes a disconnected controller and stops anything it was holding.
+ * @param id Joystick instance id from SDL_CONTROLLERDEVICEREMOVED.
+ */
+void SDLUI::closeController(SDL_JoystickID id) {
+    auto it = controllers.find(id);
+    if (it == controllers.end()) return;
+
+    SDL_GameControllerClose(it->second);
+    controllers.erase(it);
+    if (heldButton != SDL_CONTROLLER_BUTTON_INVALID) {
+        navRepeater.release();
+        heldButton = SDL_CONTROLLER_BUTTON_INVALID;
+    }
+    stickX = stickY = 0.0f;
+}
+
+/**
+ * @brief Moves once and starts repeating the move while the key or button is held.
+ */
+void SDLUI::startHold(int stride) {
+    moveSelection(stride);
+    heldStride = stride;
+    navRepeater.press();
+}
+
+/**
+ * @brief Returns how many entries one page of the current view spans.
+ */
+int SDLUI::pageStride() const {
+    if (viewMode == ViewMode::Grid) {
+        GridMetrics grid = getGridMetrics();
+        return std::max(1, grid.viewHeight / grid.pitch) * grid.columns;
+    }
+    return std::max(1, layout.height / layout.itemPitch);
+}
+
+/**
+ * @brief Switches between the list and grid views, keeping the selection in view.
+ */
+void SDLUI::toggleView() {
+    viewMode = viewMode == ViewMode::Grid ? ViewMode::List : ViewMode::Grid;
+    prefetchReset = true;
+    ensureSelectionVisible();
+}
+
+/**
+ * @brief Launches the selected game, if the view has any.
+ */
+void SDLUI::confirmSelection() {
+    if (!visibleRows.empty()) {
+        gameSelected = true;  // Set flag to indicate game was selected
+    }
+}
+
+/**
+ * @brief Opens the detail pane on the selected game and requests its extended fields.
+ *
+ * The loader starts on first use, so a session that never opens a pane
+ * never fetches details.
+ */
+void SDLUI::openDetails() {
+    if (selectedIndex < 0 || selectedIndex >= rowCount()) return;
+
+    detailGame = gameAtRow(selectedIndex);
+    detailOpen = true;
+    navRepeater.release();
+    heldKey = SDLK_UNKNOWN;
+    heldButton = SDL_CONTROLLER_BUTTON_INVALID;
+
+    requestDetails();
+}
+
+/**
+ * @brief Requests the extended fields of detailGame, starting the loader if needed.
+ */
+void SDLUI::requestDetails() {
+    const std::string& url = catalog.igdbUrl(detailGame);
+    if (!url.empty()) {
+        if (!detailLoader.isRunning()) {
+            detailLoader.start(igdbInitialized ? &igdbClient : nullptr);
+        }
+        detailLoader.request(url);
+    }
+}
+
+/**
+ * @brief Closes the detail pane, back to the view it was opened from.
+ */
+void SDLUI::closeDetails() {
+    detailOpen = false;
+}
+
+/**
+ * @brief Closes the detail pane or leaves the search if either is open, otherwise exits the launcher.
+ */
+void SDLUI::goBack() {
+    if (detailOpen) {
+        closeDetails();
+    } else if (!searchQuery.empty()) {
+        searchQuery.clear();  // First Escape only leaves the search
+        applySearch();
+    } else {
+        selectedIndex = -1;  // Signal to exit
+    }
+}
+
+/**
+ * @brief Drags the current view with a finger and flings it on release.
+ * @param finger The touch event; coordinates are normalized to the window.
+ */
+void SDLUI::handleTouch(const SDL_TouchFingerEvent& finger) {
+    if (detailOpen) return;
+    ScrollAnimator& scroll = activeScroll();
+
+    if (finger.type == SDL_FINGERDOWN) {
+        scroll.jumpTo(scroll.getPosition());  // Catch a moving list
+        touchVelocity = 0.0f;
+        lastTouchTime = finger.timestamp;
+        return;
+    }
+
+    if (finger.type == SDL_FINGERMOTION) {
+        float delta = -finger.dy * layout.height;
+        scroll.dragBy(delta);
+
+        // Exponentially smoothed velocity from the event timestamps
+        float elapsed = std::max(1u, finger.timestamp - lastTouchTime) / 1000.0f;
+        touchVelocity = 0.7f * touchVelocity + 0.3f * (delta / elapsed);
+        lastTouchTime = finger.timestamp;
+        return;
+    }
+
+    scroll.fling(touchVelocity);
+    touchVelocity = 0.0f;
+}
+
+/**
+ * @brief Handles a left click in the current view.
+ *
+ * In the list, clicking a Read More link opens the game's detail pane. In
+ * the grid, clicking a tile selects it and clicking the selected tile
+ * launches it. With the pane open, a click outside it closes it.
+ *
+ * @param x Click x-coordinate in window pixels.
+ * @param y Click y-coordinate in window pixels.
+ */
+void SDLUI::handleClick(int x, int y) {
+    const int count = rowCount();
+
+    if (detailOpen) {
+        SDL_Point click = {x, y};
+        SDL_Rect panel = {layout.detailX, layout.detailY, layout.detailWidth, layout.detailHeight};
+        if (!SDL_PointInRect(&click, &panel)) {
+            closeDetails();
+        }
+        return;
+    }
+
+    if (viewMode == ViewMode::Grid) {
+        GridMetrics grid = getGridMetrics();
+        if (y >= grid.viewHeight || x < grid.offsetX) return;
+
+        int col = (x - grid.offsetX) / grid.pitch;
+        int row = (y + static_cast<int>(gridScroll.getPosition()) - layout.gridGap) / grid.pitch;
+        int i = row * grid.columns + col;
+        if (col >= grid.columns || i < 0 || i >= count) return;
+
+        if (i == selectedIndex) {
+            gameSelected = true;
+        } else {
+            selectedIndex = i;
+            ensureSelectionVisible();
+        }
+        return;
+    }
+
+    // Calculate which game item was clicked
+    const int pitch = layout.itemPitch;
+    const int scrollY = static_cast<int>(listScroll.getPosition());
+    int i = (y + scrollY - layout.itemPadding) / pitch;
+    if (i < 0 || i >= count) return;
+
+    const GameId game = gameAtRow(i);
+    int itemY = layout.itemPadding + i * pitch - scrollY;
+
+    // Check if click hit the Read More link of a game with an IGDB URL
+    if (catalog.hasIgdbUrl(game)) {
+        const TextLayout& description = layoutDescription(catalog.description(game), layout.descriptionWidth, true);
+        SDL_Point click = {x, y};
+        SDL_Rect link = description.linkRect;
+        link.x += layout.textX;
+        link.y += itemY + layout.descriptionY;
+
+        if (description.hasLink && SDL_PointInRect(&click, &link)) {
+            selectedIndex = i;
+            openDetails();
+        }
+    }
+}
+
+/**
+ * @brief Appends typed text to the search query and refilters.
+ * @param text UTF-8 text from an SDL_TEXTINPUT event.
+ */
+void SDLUI::handleTextInput(const char* text) {
+    if (detailOpen) return;  // Typing does not search behind the pane
+    // With no query yet, these keys keep their zoom meaning and a space does nothing
+    if (searchQuery.empty() && text[0] != '\0' && text[1] == '\0' && std::strchr("+-= ", text[0])) {
+        return;
+    }
+    searchQuery += text;
+    applySearch();
+}
+
+/**
+ * @brief Refilters the visible rows for the current query.
+ *
+ * The selected game stays selected if it still matches; otherwise the
+ * first match is selected.
+ */
+void SDLUI::applySearch() {
+    int previous = -1;
+    if (selectedIndex >= 0 && selectedIndex < rowCount()) {
+        previous = static_cast<int>(visibleRows[selectedIndex]);
+    }
+
+    const std::vector<uint32_t>& matches = titleIndex.search(searchQuery);
+    visibleRows.assign(matches.begin(), matches.end());
+    prefetchReset = true;
+    rowsVersion++;
+
+    // Rows keep library order, so the old selection can be found by bisection
+    auto it = std::lower_bound(visibleRows.begin(), visibleRows.end(), static_cast<uint32_t>(previous));
+    if (previous >= 0 && it != visibleRows.end() && *it == static_cast<uint32_t>(previous)) {
+        selectedIndex = static_cast<int>(it - visibleRows.begin());
+    } else {
+        selectedIndex = 0;
+    }
+
+    updateScrollBounds();
+    ensureSelectionVisible();
+}
+
+/**
+ * @brief Selects the first title starting with initial, or the next one when
+ *        the selection already starts with it.
+ *
+ * The jump table covers the whole library, so an active search is cleared.
+ */
+void SDLUI::jumpToInitial(char initial) {
+    if (!searchQuery.empty()) {
+        searchQuery.clear();
+        applySearch();
+    }
+
+    int current = (selectedIndex >= 0 && selectedIndex < rowCount()) ? static_cast<int>(visibleRows[selectedIndex]) : -1;
+    std::string currentTitle = current >= 0 ? TitleIndex::fold(catalog.title(current)) : std::string();
+
+    int target = (!currentTitle.empty() && currentTitle[0] == initial)
+        ? titleIndex.nextWithInitial(initial, current)
+        : titleIndex.firstWithInitial(initial);
+    if (target >= 0) {
+        selectedIndex = target;  // No filter is active, so rows are library positions
+        ensureSelectionVisible();
+    }
+}
+
+/**
+ * @brief Loads metadata for games, then displays the list and handles user interaction.
+ * @param games A vector containing game filenames.
+ * @return The index of the selected game, or -1 if the user exits.
+ */
+int SDLUI::displayGameList(const std::vector<std::string>& games) {
+    loadGameMetadata(games);
+    return displayGameList();
+}
+
+/**
+ * @brief Displays the current library and handles user interaction.
+ *
+ * Search, selection and scroll position are kept from the previous call,
+ * so returning from a game shows the list as it was left.
+ *
+ * @return The library index of the selected game, or -1 if the user exits.
+ */
+int SDLUI::displayGameList() {
+    if (catalog.empty()) {
+        return -1;
+    }
+    gameSelected = false;  // Reset selection flag
+    navRepeater.release();
+    dwellGame = -1;  // A launch used up what was prepared; time the selection afresh
+    dwellFired = false;
+    updateScrollBounds();
+    ensureSelectionVisible();
+
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const double FRAME_SECONDS = 1.0 / 60.0;
+    Uint64 previous = SDL_GetPerformanceCounter();
+    
+    while (true) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        // Clamp so a stall (window drag, debugger) does not fling content away
+        float dt = static_cast<float>(std::min(0.25, (now - previous) / frequency));
+        previous = now;
+
+        if (!runFrame(dt)) {
+            break;
+        }
+        
+        // Cap at ~60 FPS, sleeping only for what is left of the frame
+        double spent = (SDL_GetPerformanceCounter() - now) / frequency;
+        if (spent < FRAME_SECONDS) {
+            SDL_Delay(static_cast<Uint32>((FRAME_SECONDS - spent) * 1000.0));
+        }
+    }
+
+    if (selectedIndex == -1) {
+        return -1;  // Exit selected
+    }
+    navRepeater.release();
+    return static_cast<int>(visibleRows[selectedIndex]);  // Library index of the selected game
+}
+
+/**
+ * @brief Replaces the library with already-resolved metadata, bypassing IGDB.
+ * @param games Entries to display; covers are requested lazily as rows come into view.
+ */
+void SDLUI::setGameLibrary(std::vector<GameMetadata> games) {
+    catalog.clear();
+    rowTextureCache.clear();
+    catalog.reserve(games.size());
+    for (const GameMetadata& game : games) {
+        catalog.add(game);
+    }
+    titleIndex.build(catalog);
+    searchQuery.clear();
+    visibleRows.clear();
+    applySearch();
+    selectedIndex = 0;
+    gameSelected = false;
+    detailOpen = false;
+    navRepeater.release();
+    updateScrollBounds();
+    listScroll.jumpTo(0.0f);
+    gridScroll.jumpTo(0.0f);
+}
+
+/**
+ * @brief Queues a library to replace the displayed one on the next frame. Safe to call from any thread.
+ * @param games Entries to display, e.g. the IGDB metadata of games first shown by filename.
+ */
+void SDLUI::postGameLibrary(std::vector<GameMetadata> games) {
+    std::lock_guard<std::mutex> lock(pendingLibraryMutex);
+    pendingLibrary = std::move(games);
+    libraryPending = true;
+}
+
+/**
+ * @brief Installs a library queued by postGameLibrary().
+ *
+ * When it holds the same ROMs in the same order, as when IGDB metadata
+ * replaces filename titles, the search, selection, scroll positions and
+ * an open detail pane are kept, so the update never moves the user.
+ */
+void SDLUI::applyPendingLibrary() {
+    std::vector<GameMetadata> games;
+    {
+        std::lock_guard<std::mutex> lock(pendingLibraryMutex);
+        if (!libraryPending) return;
+        libraryPending = false;
+        games.swap(pendingLibrary);
+    }
+
+    bool sameGames = games.size() == catalog.size();
+    for (size_t i = 0; sameGames && i < games.size(); ++i) {
+        sameGames = games[i].filename == catalog.filename(static_cast<GameId>(i));
+    }
+    if (!sameGames) {
+        setGameLibrary(std::move(games));
+        return;
+    }
+
+    const std::string query = searchQuery;
+    const int selected = selectedIndex >= 0 && selectedIndex < rowCount() ? static_cast<int>(gameAtRow(selectedIndex)) : -1;
+    const bool wasDetailOpen = detailOpen;
+    const float listPosition = listScroll.getPosition();
+    const float gridPosition = gridScroll.getPosition();
+
+    setGameLibrary(std::move(games));
+    listScroll.jumpTo(listPosition);
+    gridScroll.jumpTo(gridPosition);
+    // Unfiltered, rows are library positions; applySearch() finds the selection among the matches
+    selectedIndex = std::max(selected, 0);
+    searchQuery = query;
+    applySearch();
+    if (wasDetailOpen) {
+        // The game may only now have an IGDB page to fetch details from
+        detailOpen = true;
+        requestDetails();
+    }
+}
+
+/**
+ * @brief Runs one update/upload/render/input cycle without any frame pacing.
+ * @param dt Seconds since the previous frame.
+ * @return false once a game was chosen or the user asked to exit.
+ */
+bool SDLUI::runFrame(float dt) {
+    profiler.beginFrame();
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::Layout);
+        update(dt);
+    }
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::Upload);
+        uploadDecodedImages();
+    }
+    renderGameList();
+    {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::Input);
+        handleInput();
+    }
+    profiler.endFrame();
+
+    return selectedIndex != -1 && !gameSelected;
+}
+
+/**
+ * @brief Displays an error message on the screen.
+ * @param message The error message to display.
+ */
+
 void SDLUI::showError(const std::string& message) {
     // Clear screen
     SDL_SetRenderDrawColor(renderer, backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
     SDL_RenderClear(renderer);
     
     // Render error message
-    renderText("Error: " + message, 20, 20, errorColor);
-    renderText("Press ESC to continue", 20, 40, textColor);
+    renderText("Error: " + message, layout.px(20), layout.px(20), errorColor);
+    renderText("Press ESC to continue", layout.px(20), layout.px(40), textColor);
     
     SDL_RenderPresent(renderer);
     
@@ -451,15 +2579,286 @@ void SDLUI::showError(const std::string& message) {
         SDL_Delay(16);
     }
 }
+
+/**
+ * @brief Hibernates while a game runs, until notifyGameExited() is called.
+ *
+ * The launcher releases its textures and decoders, shows which game is
+ * running and blocks in SDL_WaitEvent(), redrawing the notice only when
+ * the window system asks. Closing the launcher window during play is
+ * ignored, since the game is the window that matters.
+ *
+ * @param title The title of the running game.
+ */
+void SDLUI::waitForGame(const std::string& title) {
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    hibernate();
+
+    auto draw = [&]() {
+        if (compositor) {
+            compositor->invalidateAll();
+            compositor->beginFrame(layout.width, layout.height);
+        }
+        SDL_SetRenderDrawColor(renderer, backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
+        SDL_RenderClear(renderer);
+        renderText("Playing " + title, layout.px(20), layout.px(20), textColor);
+        renderText("The menu returns when the game exits", layout.px(20), layout.px(40), textColor);
+        SDL_RenderPresent(renderer);
+        if (compositor) {
+            compositor->present(window);
+        }
+    };
+    draw();
+    hibernation.residentDuring = residentMemoryBytes();
+    const double cpuStart = processCpuSeconds();
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    SDL_Event event;
+    while (SDL_WaitEvent(&event)) {
+        if (event.type == gameExitEvent) {
+            break;
+        }
+        if (event.type != SDL_WINDOWEVENT) {
+            continue;
+        }
+        if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || event.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED) {
+            // Lay out for the new size now, or the menu comes back sized for the old window
+            if (compositor) {
+                // The new renderer frees the old one's textures, so the cache must not keep them
+                clearTextureCache();
+                createSoftwareRenderer(true);
+            }
+            updateLayout();
+            if (!snapshot.empty() && (snapshot.getWidth() != layout.width || snapshot.getHeight() != layout.height)) {
+                dropSnapshot();
+            }
+            draw();
+        } else if (event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+            draw();
+        }
+    }
+
+    const Uint64 woke = SDL_GetPerformanceCounter();
+    hibernation.seconds = (woke - start) / frequency;
+    hibernation.cpuMillis = (processCpuSeconds() - cpuStart) * 1000.0;
+    resume();
+    hibernation.resumeMillis = (SDL_GetPerformanceCounter() - woke) * 1000.0 / frequency;
+
+    // Keys held at launch were released in the game
+    navRepeater.release();
+}
+
+/**
+ * @brief Services the window while a launch waits for the emulator.
+ *
+ * Window events are handled so the menu stays drawn and the window
+ * manager does not consider the launcher hung. Input is discarded: keys
+ * pressed while a game starts are meant for the game, not the menu.
+ */
+void SDLUI::pumpEvents() {
+    SDL_Event event;
+    bool redraw = false;
+    while (SDL_PollEvent(&event)) {
+        if (event.type != SDL_WINDOWEVENT) {
+            continue;
+        }
+        if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || event.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED) {
+            updateLayout();
+            redraw = true;
+        } else if (event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+            redraw = true;
+        }
+    }
+    if (redraw) {
+        if (compositor) {
+            compositor->invalidateAll();
+        }
+        renderGameList();
+    }
+}
+
+/**
+ * @brief Saves the menu as it looks, then releases everything a redraw can rebuild.
+ *
+ * GPU textures, the decode workers and their finished surfaces, and the
+ * detail worker with the details it fetched go, and freed heap is handed
+ * back to the system. The menu frame is kept compressed. The software
+ * framebuffer, sized for the largest display, shrinks to the window. The
+ * catalog, search index and wrapped descriptions stay: they are compact
+ * and slow to rebuild.
+ */
+void SDLUI::hibernate() {
+    hibernation = HibernationStats();
+    hibernation.residentBefore = residentMemoryBytes();
+
+    dropSnapshot();
+    if (compositor) {
+        saveSnapshot(compositor->getFramebuffer(), layout.width, layout.height);
+    } else {
+        snapshotPending = true;
+        renderGameList();
+    }
+    hibernation.snapshotBytes = snapshot.getBytes();
+
+    imageLoader.stop();
+    detailsSuspended = detailLoader.isRunning();
+    detailLoader.stop();
+    clearTextureCache();
+    placeholderLoaded = false;
+    lastDrawnTexture = nullptr;
+    drawnStateValid = false;
+    if (compositor) {
+        createSoftwareRenderer(true);
+    }
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+/**
+ * @brief Restarts the decoders, puts the saved menu back on screen and draws the live menu.
+ *
+ * The snapshot stays up until the covers in view are resident again or
+ * RESUME_HOLD_MS has passed, so the menu does not come back as previews
+ * first unless decoding would break the resume budget.
+ */
+void SDLUI::resume() {
+    if (compositor) {
+        // Back to a framebuffer for the largest display; the notice's textures go with the old one
+        clearTextureCache();
+        createSoftwareRenderer();
+    }
+    imageLoader.start();
+    loadPlaceholder();
+    prefetchReset = true;
+    if (detailsSuspended) {
+        // An open pane gets its details back from the disk cache
+        detailsSuspended = false;
+        detailLoader.start(igdbInitialized ? &igdbClient : nullptr);
+        if (detailOpen) {
+            requestDetails();
+        }
+    }
+
+    if (presentSnapshot()) {
+        const Uint32 deadline = SDL_GetTicks() + RESUME_HOLD_MS;
+        while (!restoreVisibleCovers() && !SDL_TICKS_PASSED(SDL_GetTicks(), deadline)) {
+            SDL_Delay(1);
+            uploadDecodedImages();
+        }
+    }
+    if (compositor) {
+        compositor->invalidateAll();
+    }
+    renderGameList();
+}
+
+/**
+ * @brief Compresses the top-left part of a frame, the size of the view, for presentSnapshot().
+ */
+void SDLUI::saveSnapshot(SDL_Surface* frame, int width, int height) {
+    if (frame && !snapshot.capture(frame, width, height)) {
+        std::cerr << "Failed to save the menu snapshot: " << SDL_GetError() << std::endl;
+    }
+}
+
+/**
+ * @brief Frees the saved menu frame.
+ */
+void SDLUI::dropSnapshot() {
+    snapshot.clear();
+}
+
+/**
+ * @brief Expands the saved menu frame, presents it and frees it.
+ * @return false if there was no snapshot, the view changed size, or it could not be shown.
+ */
+bool SDLUI::presentSnapshot() {
+    SDL_Surface* frame = nullptr;
+    if (snapshot.getWidth() == layout.width && snapshot.getHeight() == layout.height) {
+        frame = snapshot.expand();
+    }
+    snapshot.clear();
+    if (!frame) {
+        return false;
+    }
+
+    bool shown = false;
+    if (compositor) {
+        compositor->invalidateAll();
+        compositor->beginFrame(layout.width, layout.height);
+        SDL_SetSurfaceBlendMode(frame, SDL_BLENDMODE_NONE);
+        shown = SDL_BlitSurface(frame, nullptr, compositor->getFramebuffer(), nullptr) == 0 && compositor->present(window);
+    } else if (SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, frame)) {
+        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+        SDL_RenderPresent(renderer);
+        SDL_DestroyTexture(texture);
+        shown = true;
+    }
+    SDL_FreeSurface(frame);
+    return shown;
+}
+
+/**
+ * @brief Requests the covers in view that are not resident yet.
+ * @return true once all of them are resident (or failed to load).
+ */
+bool SDLUI::restoreVisibleCovers() {
+    const int level = prefetchLevel >= 0 ? prefetchLevel : LIST_COVER_LEVEL;
+    bool ready = true;
+    for (int i = visibleFirst; i <= visibleLast; ++i) {
+        const std::string& path = catalog.imagePath(gameAtRow(i));
+        if (path.empty() || failedImages.count(path) || coverLevels[level]->contains(path)) continue;
+        if (coverDeferred(path, level)) continue;  // Shown at another level; the hold cannot wait for it
+        imageLoader.request(path, COVER_LEVEL_SIZES[level]);
+        ready = false;
+    }
+    return ready;
+}
+
+/**
+ * @brief Wakes waitForGame(). Safe to call from any thread.
+ */
+void SDLUI::notifyGameExited() {
+    if (gameExitEvent == static_cast<Uint32>(-1)) return;
+
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = gameExitEvent;
+    SDL_PushEvent(&event);
+}
+
 /**
  * @brief Cleans up SDL resources before exiting.
  */
 void SDLUI::cleanup() {
+    // Stop decoding before IMG_Quit, and destroy textures before the renderer
+    detailLoader.stop();
+    imageLoader.stop();
+    clearTextureCache();
+    dropSnapshot();
+    placeholderLoaded = false;
+    if (placeholderArt) {
+        SDL_FreeSurface(placeholderArt);
+        placeholderArt = nullptr;
+    }
+
+    for (auto& entry : controllers) {
+        SDL_GameControllerClose(entry.second);
+    }
+    controllers.clear();
+
     if (font) {
         TTF_CloseFont(font);
         font = nullptr;
     }
-    if (renderer) {
+    glyphAtlas.reset();
+    assets.close();  // After the font, which reads from the mapping
+    if (compositor) {
+        compositor->destroy();  // Owns the renderer and its framebuffer
+        compositor.reset();
+        renderer = nullptr;
+    } else if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = nullptr;
     }
@@ -473,20 +2872,171 @@ void SDLUI::cleanup() {
     initialized = false;
 }
 
+/**
+ * @brief Destroys all cached cover and text textures.
+ */
 void SDLUI::clearTextureCache() {
-    for (auto& pair : textureCache) {
-        if (pair.second) {
-            SDL_DestroyTexture(pair.second);
-        }
+    for (auto& atlas : coverLevels) {
+        atlas->clear();
     }
-    textureCache.clear();
-
-    for (auto& pair : textTextureCache) {
-        if (pair.second) {
-            SDL_DestroyTexture(pair.second);
-        }
+    for (auto& deferred : deferredCovers) {
+        deferred.clear();
     }
+    previewAtlas->clear();
     textTextureCache.clear();
+    rowTextureCache.clear();
+}
+
+/**
+ * @brief Sets the byte budgets of the cover atlases, text texture cache and row cache.
+ *
+ * Cover pages are shared out between the thumbnail levels by
+ * COVER_LEVEL_PAGE_WEIGHTS; see updateCoverPageLimits().
+ *
+ * @param coverBytes GPU memory for cover atlas pages (rounded down to whole pages).
+ * @param textBytes Maximum estimated GPU memory for rasterized text.
+ * @param rowBytes Maximum estimated GPU memory for composited list rows.
+ */
+void SDLUI::setTextureCacheBudgets(size_t coverBytes, size_t textBytes, size_t rowBytes) {
+    coverBudgetBytes = coverBytes;
+    updateCoverPageLimits();
+    textTextureCache.setBudget(textBytes);
+    rowTextureCache.setBudget(rowBytes);
+}
+
+/**
+ * @brief Returns the most covers that can be on screen at once drawn from a thumbnail level.
+ *
+ * Grid tiles between GRID_MIN_TILE_SIZE and GRID_MAX_TILE_SIZE map to a
+ * level by their pixel size, so the smallest tile a level serves decides
+ * how many of them fit. List rows use the level of their cover size.
+ * Partly visible rows at the top and bottom count too.
+ */
+int SDLUI::screenCoverCells(int level) const {
+    if (layout.width <= 0) {
+        return 0;
+    }
+    int cells = 0;
+
+    const int lowest = level > 0 ? COVER_LEVEL_SIZES[level - 1] + 1 : 1;
+    const int highest = level < COVER_LEVEL_COUNT - 1 ? COVER_LEVEL_SIZES[level] : INT_MAX;
+    const int tile = std::max(lowest, layout.px(GRID_MIN_TILE_SIZE));
+    if (tile <= std::min(highest, layout.px(GRID_MAX_TILE_SIZE))) {
+        const int pitch = tile + layout.gridGap;
+        const int columns = std::max(1, (layout.width - layout.gridGap) / pitch);
+        cells = columns * (layout.gridViewHeight / pitch + 2);
+    }
+    if (coverLevelFor(layout.coverSize) == level && layout.itemPitch > 0) {
+        cells = std::max(cells, layout.height / layout.itemPitch + 2);
+    }
+    if (coverLevelFor(layout.detailCoverSize) == level) {
+        cells++;  // The detail pane's cover, over either view
+    }
+    if (level == LIST_COVER_LEVEL) {
+        cells++;  // The pinned placeholder
+    }
+    return cells;
+}
+
+/**
+ * @brief Gives each thumbnail level its share of the cover budget and room for one screen.
+ *
+ * Levels keep COVER_LEVEL_PAGE_WEIGHTS shares of coverBudgetBytes, at
+ * least one page each. A level whose covers fill every slot on screen may
+ * grow past its share up to the pages that a full screen of its tiles
+ * needs, so zooming or a HiDPI display never leaves most of the grid stuck
+ * at a lower level. Called again whenever the layout changes.
+ */
+void SDLUI::updateCoverPageLimits() {
+    int totalWeight = 0;
+    for (int weight : COVER_LEVEL_PAGE_WEIGHTS) {
+        totalWeight += weight;
+    }
+
+    size_t totalPages = coverBudgetBytes / coverLevels[0]->pageBytes();
+    for (int level = 0; level < COVER_LEVEL_COUNT; ++level) {
+        size_t pages = totalPages * COVER_LEVEL_PAGE_WEIGHTS[level] / totalWeight;
+        const int cellsPerPage = (ATLAS_PAGE_SIZE / COVER_LEVEL_SIZES[level]) * (ATLAS_PAGE_SIZE / COVER_LEVEL_SIZES[level]);
+        const int screenPages = (screenCoverCells(level) + cellsPerPage - 1) / cellsPerPage;
+        coverLevels[level]->setMaxPages(static_cast<int>(pages), screenPages);
+    }
+
+    if (placeholderLoaded && !coverLevels[LIST_COVER_LEVEL]->contains(PLACEHOLDER_KEY)) {
+        loadPlaceholder();  // Shrinking dropped the pinned slot as well
+    }
+}
+
+/**
+ * @brief Sets how many decoded covers may be uploaded to the GPU per frame.
+ * @param texturesPerFrame Maximum number of textures created per frame.
+ * @param bytesPerFrame Maximum number of pixel bytes uploaded per frame.
+ */
+void SDLUI::setUploadBudget(int texturesPerFrame, size_t bytesPerFrame) {
+    uploadsPerFrame = std::max(1, texturesPerFrame);
+    uploadBytesPerFrame = bytesPerFrame;
+}
+
+/**
+ * @brief Returns hit/miss/eviction counters and resident bytes for cover textures.
+ */
+TextureCacheStats SDLUI::getCoverCacheStats() const {
+    TextureCacheStats total;
+    auto add = [&total](const CoverAtlas& atlas) {
+        TextureCacheStats level = atlas.getStats();
+        total.hits += level.hits;
+        total.misses += level.misses;
+        total.evictions += level.evictions;
+        total.entries += level.entries;
+        total.residentBytes += level.residentBytes;
+        total.budgetBytes += level.budgetBytes;
+    };
+    for (const auto& atlas : coverLevels) {
+        add(*atlas);
+    }
+    add(*previewAtlas);
+    return total;
+}
+
+/**
+ * @brief Returns the loaded game library.
+ */
+const GameCatalog& SDLUI::getCatalog() const {
+    return catalog;
+}
+
+/**
+ * @brief Returns how often covers were ready when their row scrolled into view.
+ */
+PrefetchStats SDLUI::getPrefetchStats() const {
+    return prefetchStats;
+}
+
+/**
+ * @brief Returns the frame-time profiler, e.g. to read percentiles after a run.
+ */
+const FrameProfiler& SDLUI::getFrameProfiler() const {
+    return profiler;
+}
+
+/**
+ * @brief Returns the draw-call and texture-switch counts of the last presented frame.
+ */
+RenderStats SDLUI::getLastFrameRenderStats() const {
+    return lastFrameStats;
+}
+
+/**
+ * @brief Returns hit/miss/eviction counters and resident bytes for text textures.
+ */
+TextureCacheStats SDLUI::getTextCacheStats() const {
+    return textTextureCache.getStats();
+}
+
+/**
+ * @brief Returns hit/miss/eviction counters and resident bytes for composited list rows.
+ */
+TextureCacheStats SDLUI::getRowCacheStats() const {
+    return rowTextureCache.getStats();
 }
 
 SDL_Texture* SDLUI::getOrCreateTextTexture(const std::string& text, const SDL_Color& color) {
@@ -494,12 +3044,16 @@ SDL_Texture* SDLUI::getOrCreateTextTexture(const std::string& text, const SDL_Co
     std::string key = text + std::to_string(color.r) + std::to_string(color.g) + 
                      std::to_string(color.b) + std::to_string(color.a);
     
-    auto it = textTextureCache.find(key);
-    if (it != textTextureCache.end()) {
-        return it->second;
+    if (SDL_Texture* cached = textTextureCache.get(key)) {
+        return cached;
     }
 
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
+    FrameProfiler::Scope scope(profiler, FrameProfiler::Text);
+    // Baked glyphs cover printable ASCII at the pack's sizes; anything else goes through FreeType
+    SDL_Surface* surface = glyphAtlas.render(text, color);
+    if (!surface) {
+        surface = TTF_RenderText_Blended(font, text.c_str(), color);
+    }
     if (!surface) {
         std::cerr << "Failed to render text surface! TTF_Error: " << TTF_GetError() << std::endl;
         return nullptr;
@@ -513,6 +3067,6 @@ SDL_Texture* SDLUI::getOrCreateTextTexture(const std::string& text, const SDL_Co
     }
 
     SDL_FreeSurface(surface);
-    textTextureCache[key] = texture;
+    textTextureCache.put(key, texture);
     return texture;
 } 
\ No newline at end of file
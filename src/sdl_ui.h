@@ -10,41 +10,217 @@
 #include <string>
 #include <vector>
 #include "game_metadata.h"
+#include "game_catalog.h"
 #include "igdb_client.h"
+#include "texture_cache.h"
+#include "text_layout.h"
+#include "image_loader.h"
+#include "cover_atlas.h"
+#include "render_stats.h"
+#include "scroll_animator.h"
+#include "frame_profiler.h"
+#include "ui_layout.h"
+#include "title_index.h"
+#include "scroll_predictor.h"
+#include "software_compositor.h"
+#include "asset_pack.h"
+#include "glyph_atlas.h"
+#include "detail_loader.h"
+#include "cover_preview.h"
+#include "frame_snapshot.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @brief What the launcher cost while a game ran, and how quickly it came back.
+ */
+struct HibernationStats {
+    double seconds = 0.0;         ///< Time spent hibernating.
+    double cpuMillis = 0.0;       ///< User and system CPU time the launcher used meanwhile.
+    size_t residentBefore = 0;    ///< Resident set size before caches were released.
+    size_t residentDuring = 0;    ///< Resident set size while the game ran.
+    size_t snapshotBytes = 0;     ///< Compressed size of the saved menu frame.
+    double resumeMillis = 0.0;    ///< From the game's exit to the menu being back on screen.
+};
 
 class SDLUI {
 public:
+    static const size_t DEFAULT_COVER_CACHE_BYTES = 48 * 1024 * 1024;
+    static const size_t DEFAULT_TEXT_CACHE_BYTES = 16 * 1024 * 1024;
+    static const size_t DEFAULT_ROW_CACHE_BYTES = 32 * 1024 * 1024;
+
+    /// How frames are drawn: on the GPU, or into a framebuffer on the CPU
+    enum class RenderBackend { Auto, Gpu, Software };
+
     SDLUI();
     ~SDLUI();
     
-    bool init();
+    bool init(bool headless = false, RenderBackend backend = RenderBackend::Auto);
     bool initIGDB(const std::string& client_id, const std::string& client_secret);
     void loadGameMetadata(const std::vector<std::string>& games);
     int displayGameList(const std::vector<std::string>& games);
+    int displayGameList();
+
+    // init() in stages, for overlapping startup: initAssets() is thread-agnostic and
+    // may run alongside initWindow(); finishInit() follows both on the main thread
+    bool initAssets();
+    bool initWindow(bool headless = false, RenderBackend backend = RenderBackend::Auto);
+    bool finishInit();
+    std::vector<GameMetadata> fetchGameMetadata(const std::vector<std::string>& games,
+                                                const std::atomic<bool>* cancelled = nullptr);
+    static GameMetadata basicMetadata(const std::string& filename);  ///< What a filename alone tells
     void showError(const std::string& message);
+
+    // A library resolved after startup; applied on the next frame, keeping the user's place.
+    // May be called from any thread
+    void postGameLibrary(std::vector<GameMetadata> games);
+
+    // While a game runs the launcher only waits; notifyGameExited() may be called from any thread
+    void waitForGame(const std::string& title);
+    void notifyGameExited();
+    void pumpEvents();  ///< Keeps the window responsive while a launch is in progress
+    const HibernationStats& getLastHibernation() const { return hibernation; }
     void cleanup();
 
+    // Texture cache sizing and statistics
+    void setTextureCacheBudgets(size_t coverBytes, size_t textBytes, size_t rowBytes = DEFAULT_ROW_CACHE_BYTES);
+    TextureCacheStats getCoverCacheStats() const;
+    TextureCacheStats getTextCacheStats() const;
+    TextureCacheStats getRowCacheStats() const;
+    void setUploadBudget(int texturesPerFrame, size_t bytesPerFrame);
+    RenderStats getLastFrameRenderStats() const;
+    const FrameProfiler& getFrameProfiler() const;
+    PrefetchStats getPrefetchStats() const;
+    const GameCatalog& getCatalog() const;
+    bool isSoftwareRendering() const { return compositor != nullptr; }
+
+    // User scale on top of the HiDPI/DPI scale, e.g. for a TV viewed from a distance
+    void setUiScale(float scale);
+
+    // Hold-to-repeat acceleration for keyboard arrows and for pad d-pads/shoulders
+    void setRepeatCurves(const RepeatCurve& keyboard, const RepeatCurve& controller);
+
+    // Called with a library index once the selection has rested on it for a while,
+    // and with -1 when it moves on, so the caller can prepare a launch speculatively
+    using DwellCallback = std::function<void(int)>;
+    static constexpr float DEFAULT_DWELL_SECONDS = 0.3f;
+    void setDwellCallback(DwellCallback callback, float seconds = DEFAULT_DWELL_SECONDS);
+
+    // Frame stepping for callers that drive their own loop (benchmarks)
+    void setGameLibrary(std::vector<GameMetadata> games);
+    bool runFrame(float dt);
+
 private:
-    static const int WINDOW_WIDTH = 800;
-    static const int WINDOW_HEIGHT = 600;
-    static const int GAME_ITEM_HEIGHT = 140;
-    static const int GAME_ITEM_PADDING = 20;
-    static const int DESCRIPTION_LINE_HEIGHT = 25;
+    static const int DEFAULT_WINDOW_WIDTH = 800;
+    static const int DEFAULT_WINDOW_HEIGHT = 600;
+    static const int MIN_WINDOW_WIDTH = 480;
+    static const int MIN_WINDOW_HEIGHT = 360;
     static const int MAX_DESCRIPTION_LINES = 2;
-    static const int COVER_IMAGE_SIZE = 100;
-    static const int TEXT_START_X = 130;
+    static const int DEFAULT_UPLOADS_PER_FRAME = 4;
+    static const size_t DEFAULT_UPLOAD_BYTES_PER_FRAME = 2 * 1024 * 1024;
+    static const int ATLAS_PAGE_SIZE = 1024;
+
+    // Thumbnail levels of detail; each level has its own atlas
+    static const int COVER_LEVEL_COUNT = 4;
+    static constexpr int COVER_LEVEL_SIZES[COVER_LEVEL_COUNT] = {32, 64, 128, 256};
+    static constexpr int COVER_LEVEL_PAGE_WEIGHTS[COVER_LEVEL_COUNT] = {1, 2, 3, 2};
+    static const int LIST_COVER_LEVEL = 2;
+
+    // BlurHash previews are decoded small (the hash holds no detail) and a few per frame
+    static const int PREVIEW_CELL_SIZE = 32;
+    static const int MAX_PREVIEW_DECODES_PER_FRAME = 16;
+
+    // Cover grid zoom range, in layout units
+    static const int GRID_MIN_TILE_SIZE = 48;
+    static const int GRID_MAX_TILE_SIZE = 256;
+    static const int GRID_DEFAULT_TILE_SIZE = 96;
+
+    enum class ViewMode { List, Grid };
+
+    struct GridMetrics {
+        int tileSize;
+        int pitch;
+        int columns;
+        int offsetX;
+        int viewHeight;
+    };
+
+    // Screen geometry, recomputed only when the drawable size or scale changes
+    UILayout layout;
+    float uiScale;
+    mutable GridMetrics gridMetrics;  ///< Cached for gridMetricsTile at the current layout
+    mutable int gridMetricsTile;
 
     SDL_Window* window;
     SDL_Renderer* renderer;
+    std::unique_ptr<SoftwareCompositor> compositor;  ///< Owns renderer when drawing in software
+    AssetPack assets;       ///< Mapped font, placeholder and glyph atlases; font reads from it
+    GlyphAtlas glyphAtlas;  ///< Baked glyphs at the current font size, if the pack has that size
     TTF_Font* font;
+    int openFontSize;  ///< Point size font was opened at
     bool initialized;
-    bool igdbInitialized;
+    Uint32 gameExitEvent;      ///< SDL user event pushed by notifyGameExited()
+
+    // Hibernation while a game runs: textures and decoders are released and the
+    // last menu frame is kept, shown on resume until visible covers are back
+    static const Uint32 RESUME_HOLD_MS = 80;  ///< Leaves a frame's time within the 100 ms resume budget
+    HibernationStats hibernation;
+    FrameSnapshot snapshot;    ///< Last menu frame cropped to the view, compressed; empty if none
+    bool snapshotPending;      ///< Read the next GPU frame back before presenting it
+    bool detailsSuspended;     ///< hibernate() stopped a running detailLoader; resume() starts it again
+    std::atomic<bool> igdbInitialized;  ///< Set by initIGDB(), which may run while the menu is up
     int selectedIndex;
     bool gameSelected;
-    std::vector<GameMetadata> gameList;
+    GameCatalog catalog;
     IGDBClient igdbClient;
 
+    // Library waiting for applyPendingLibrary(), from postGameLibrary()
+    std::mutex pendingLibraryMutex;
+    std::vector<GameMetadata> pendingLibrary;
+    bool libraryPending;
+
+    // Detail pane over the selected game; its extended fields are fetched on first open
+    DetailLoader detailLoader;
+    bool detailOpen;
+    GameId detailGame;
+
+    // Selection dwell, reported to dwellCallback
+    DwellCallback dwellCallback;
+    float dwellSeconds;
+    float dwellElapsed;
+    int dwellGame;     ///< Library index being timed, or -1
+    bool dwellFired;   ///< dwellCallback was told about dwellGame
+
+    // View state
+    ViewMode viewMode;
+    ScrollAnimator listScroll;
+    ScrollAnimator gridScroll;
+    float gridTileSize;    ///< Current, animated tile edge length in layout units
+    float gridTileTarget;  ///< Tile edge length the zoom is heading to
+
+    // Hold-to-scroll and touch kinetic scrolling
+    HoldRepeater navRepeater;
+    RepeatCurve keyRepeatCurve;
+    RepeatCurve padRepeatCurve;
+    SDL_Keycode heldKey;
+    SDL_GameControllerButton heldButton;
+    int heldStride;
+    float touchVelocity;   ///< Smoothed finger velocity in pixels per second
+    Uint32 lastTouchTime;
+
+    // Game controllers, opened and closed as they are plugged in and out
+    std::unordered_map<SDL_JoystickID, SDL_GameController*> controllers;
+    float stickX;       ///< Shaped left-stick deflection, -1..1 with the dead zone removed
+    float stickY;
+    float stickStepsX;  ///< Fractional selection steps accumulated from the stick
+    float stickStepsY;
+
     // Colors
     SDL_Color backgroundColor;
     SDL_Color textColor;
@@ -52,15 +228,162 @@ private:
     SDL_Color errorColor;
     SDL_Color linkColor;
 
-    // Texture caching
-    std::unordered_map<std::string, SDL_Texture*> textureCache;
-    std::unordered_map<std::string, SDL_Texture*> textTextureCache;
+    // Texture caching: covers live in one atlas per thumbnail level, text in an LRU bounded by GPU bytes
+    std::array<std::unique_ptr<CoverAtlas>, COVER_LEVEL_COUNT> coverLevels;
+    size_t coverBudgetBytes;                   ///< Shared out between the levels by COVER_LEVEL_PAGE_WEIGHTS
+    std::unique_ptr<CoverAtlas> previewAtlas;  ///< Decoded previews, keyed by hash, shown until a level is resident
+    int previewDecodes;                        ///< Previews decoded this frame
+    TextureCache textTextureCache;
+
+    // List rows pre-composited into render targets, keyed by game and selection state
+    TextureCache rowTextureCache;
+    bool rowTargetsSupported;
+
+    // Background cover decoding and the per-frame texture upload budget
+    ImageLoader imageLoader;
+    std::unordered_set<std::string> failedImages;
+    /// Decoded covers a full level refused, per level; not requested again until it has room
+    std::array<std::unordered_set<std::string>, COVER_LEVEL_COUNT> deferredCovers;
+    SDL_Surface* placeholderArt;  ///< Decoded placeholder, kept to re-pin it after evictions
+    bool placeholderLoaded;
+    int uploadsPerFrame;
+    size_t uploadBytesPerFrame;
+
+    // Look-ahead: covers and layouts for rows predicted to scroll into view
+    ScrollPredictor scrollPredictor;
+    PrefetchStats prefetchStats;
+    bool prefetchReset;       ///< Set when rows move to other positions (search, view switch, relayout)
+    int prefetchPitch;        ///< Row pitch and columns the ranges below refer to
+    int prefetchColumns;
+    int prefetchLevel;
+    int visibleFirst;         ///< Items on screen last frame, for counting arrivals
+    int visibleLast;
+    int predictedFirst;       ///< Items of the last predicted window
+    int predictedLast;
+    std::unordered_set<std::string_view> prefetchKeep;
+
+    // Software rendering redraws only what changed since the state below was drawn
+    struct DrawnState {
+        ViewMode view;
+        int scroll;
+        int selected;
+        int tileSize;
+        int width;
+        int height;
+        int fontSize;
+        unsigned int rowsVersion;
+        bool profiler;
+        int detail;                  ///< Game in the detail pane, or -1 when closed
+        unsigned int detailVersion;  ///< DetailLoader version the pane was drawn with
+        unsigned int detailImages;   ///< detailImageSignature() when the pane was drawn
+    };
+    DrawnState drawnState;
+    bool drawnStateValid;
+    unsigned int rowsVersion;                 ///< Bumped whenever visibleRows is rebuilt
+    int drawnCoverFirst;                      ///< First item of drawnCoverSources
+    std::vector<int8_t> drawnCoverSources;    ///< Atlas level each visible cover was drawn from
+    std::vector<int8_t> coverSources;
+    SDL_Rect profilerPanel;
+
+    // Frame-time profiling and its on-screen overlay (F3 toggles, F4 dumps)
+    FrameProfiler profiler;
+    bool showProfiler;
+    std::vector<std::string> profilerLines;
+    double profilerRefreshTime;
+    std::vector<SDL_Rect> profilerBars;
+
+    // Draw submission counters
+    RenderStats frameStats;
+    RenderStats lastFrameStats;
+    SDL_Texture* lastDrawnTexture;
+
+    // Wrapped paragraph layouts, recomputed only when text, font or width change
+    TextLayoutCache layoutCache;
+
+    // Type-to-search; selectedIndex is a position in visibleRows, not a GameId
+    TitleIndex titleIndex;
+    std::string searchQuery;
+    std::vector<GameId> visibleRows;  ///< Games shown, in display order
 
     void renderText(const std::string& text, int x, int y, const SDL_Color& color);
-    void renderWrappedText(const std::string& text, const SDL_Rect& bounds, const SDL_Color& color);
+    void renderWrappedText(const std::string& text, const SDL_Rect& bounds, const SDL_Color& color, bool withReadMore);
+    const TextLayout& layoutDescription(const std::string& text, int width, bool withReadMore);
     void renderGameList();
+    void renderListView();
+    void renderRowContents(GameId game, int y);
+    SDL_Texture* getOrCreateRowTexture(GameId game, bool selected, int width, int height);
+    void renderGridView();
+    void update(float dt);
+    void prefetch(float dt);
+    void updateDwell(float dt);
+    void itemsInSpan(float top, float bottom, int pitch, int columns, int& first, int& last) const;
+    bool prefetchCover(int item, int level);
     void handleInput();
-    SDL_Texture* loadTextureFromFile(const std::string& path);
+    void handleClick(int x, int y);
+    void moveSelection(int delta);
+    void ensureSelectionVisible();
+    void updateScrollBounds();
+    ScrollAnimator& activeScroll();
+    void handleKeyDown(const SDL_KeyboardEvent& key);
+    void handleTouch(const SDL_TouchFingerEvent& finger);
+    void handleTextInput(const char* text);
+    void handleControllerButton(const SDL_ControllerButtonEvent& button);
+    void handleControllerAxis(const SDL_ControllerAxisEvent& axis);
+    void openController(int deviceIndex);
+    void closeController(SDL_JoystickID id);
+    void updateStick(float dt);
+    void startHold(int stride);
+    int pageStride() const;
+    void toggleView();
+    void confirmSelection();
+    void goBack();
+    void applySearch();
+    void jumpToInitial(char initial);
+    void renderSearchBar();
+    void renderDetailPane();
+    int renderParagraph(const std::string& text, int x, int y, int width, int maxLines, const SDL_Color& color);
+    void openDetails();
+    void closeDetails();
+    void requestDetails();
+    unsigned int detailImageSignature() const;
+    int rowCount() const { return static_cast<int>(visibleRows.size()); }
+    GameId gameAtRow(int row) const { return visibleRows[row]; }
+    GridMetrics getGridMetrics() const;
+    void updateLayout();
+    bool openFont(int size);
+    void toggleFullscreen();
+    int coverLevelFor(int pixels) const;
+    int screenCoverCells(int level) const;
+    bool coverDeferred(const std::string& path, int level);
+    void updateCoverPageLimits();
+    void flushCovers();
+    void renderProfilerOverlay();
+    void dumpFrameTimes();
+    void applyPendingLibrary();
+    void hibernate();
+    void resume();
+    void saveSnapshot(SDL_Surface* frame, int width, int height);
+    void dropSnapshot();
+    bool presentSnapshot();
+    bool restoreVisibleCovers();
+    void loadPlaceholder();
+    SDL_Surface* decodePlaceholder() const;
+    void queueCoverDraw(const std::string& path, const SDL_Rect& dst);
+    void queueGameCover(GameId game, const SDL_Rect& dst);
+    bool queueResidentCover(const std::string& path, const SDL_Rect& dst);
+    bool queuePreviewDraw(GameId game, const SDL_Rect& dst);
+    int coverSource(GameId game, int wanted) const;
+    int residentCoverLevel(const std::string& path, int wanted) const;
+    bool createSoftwareRenderer(bool viewOnly = false);
+    void collectDamage();
+    SDL_Rect selectionBounds(int index) const;
+    SDL_Rect coverBounds(int index) const;
+    void blendRect(const SDL_Rect& rect, const SDL_Color& color);
+    void uploadDecodedImages();
+    void drawTexture(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst);
+    void fillRect(const SDL_Rect& rect, const SDL_Color& color);
+    void beginFrame();
+    void endFrame();
     SDL_Texture* getOrCreateTextTexture(const std::string& text, const SDL_Color& color);
     void clearTextureCache();
 }; 
\ No newline at end of file
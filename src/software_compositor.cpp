@@ -0,0 +1,411 @@
+/**
+ * @file software_compositor.cpp
+ * @brief Implements the framebuffer, damage tracking and SIMD blits of SoftwareCompositor.
+ */
+
+#include "software_compositor.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RETRO_HAVE_SSE2 1
+#endif
+
+namespace {
+
+const Uint32 ALPHA_MASK = 0xFF000000u;
+
+/**
+ * @brief Returns x / 255 rounded, exact for every product of two bytes.
+ */
+inline Uint32 div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * @brief Blends one straight-alpha ARGB8888 pixel over an opaque one.
+ */
+inline Uint32 blendPixel(Uint32 src, Uint32 dst) {
+    Uint32 alpha = src >> 24;
+    if (alpha == 255) return src;
+    if (alpha == 0) return dst;
+
+    Uint32 inverse = 255 - alpha;
+    Uint32 r = div255(((src >> 16) & 0xFF) * alpha + ((dst >> 16) & 0xFF) * inverse);
+    Uint32 g = div255(((src >> 8) & 0xFF) * alpha + ((dst >> 8) & 0xFF) * inverse);
+    Uint32 b = div255((src & 0xFF) * alpha + (dst & 0xFF) * inverse);
+    return ALPHA_MASK | (r << 16) | (g << 8) | b;
+}
+
+#ifdef RETRO_HAVE_SSE2
+/**
+ * @brief Divides eight 16-bit products by 255 with rounding.
+ */
+inline __m128i div255x8(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/**
+ * @brief Blends four straight-alpha source pixels over four destination pixels.
+ */
+inline __m128i blend4(__m128i src, __m128i dst) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+
+    __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+    __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+    __m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+    __m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+
+    // Broadcast each pixel's alpha (lane 3 of its four) across its lanes
+    __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo), _mm_mullo_epi16(dstLo, _mm_sub_epi16(full, alphaLo)));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi), _mm_mullo_epi16(dstHi, _mm_sub_epi16(full, alphaHi)));
+    __m128i blended = _mm_packus_epi16(div255x8(lo), div255x8(hi));
+    return _mm_or_si128(blended, _mm_set1_epi32(static_cast<int>(ALPHA_MASK)));
+}
+#endif
+
+/**
+ * @brief Blends a row of gathered source pixels over a framebuffer row.
+ *
+ * Runs of four fully transparent or fully opaque pixels, which make up
+ * almost all of a cover, skip the arithmetic.
+ */
+void blendRow(const Uint32* src, Uint32* dst, int width) {
+    int x = 0;
+#ifdef RETRO_HAVE_SSE2
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(ALPHA_MASK));
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= width; x += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+        __m128i alpha = _mm_and_si128(s, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF) {
+            continue;
+        }
+        __m128i* out = reinterpret_cast<__m128i*>(dst + x);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128(out, s);
+        } else {
+            _mm_storeu_si128(out, blend4(s, _mm_loadu_si128(out)));
+        }
+    }
+#endif
+    for (; x < width; ++x) {
+        dst[x] = blendPixel(src[x], dst[x]);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a compositor without a framebuffer. Call create() before drawing.
+ */
+SoftwareCompositor::SoftwareCompositor()
+    : framebuffer(nullptr), renderer(nullptr), viewWidth(0), viewHeight(0), clip{0, 0, 0, 0},
+      fullDamage(true), presentedPixels(0) {}
+
+/**
+ * @brief Destroys the renderer and the framebuffer.
+ */
+SoftwareCompositor::~SoftwareCompositor() {
+    destroy();
+}
+
+/**
+ * @brief Creates the framebuffer and a software renderer that draws into it.
+ * @param window The window frames are presented to.
+ * @param viewOnly Size the framebuffer to the window instead, e.g. while hibernating.
+ * @return The renderer, or nullptr on failure.
+ */
+SDL_Renderer* SoftwareCompositor::create(SDL_Window* window, bool viewOnly) {
+    destroy();
+
+    int width = 0, height = 0;
+    getViewSize(window, width, height);
+    for (int display = 0; !viewOnly && display < SDL_GetNumVideoDisplays(); ++display) {
+        SDL_Rect bounds;
+        if (SDL_GetDisplayBounds(display, &bounds) == 0) {
+            width = std::max(width, bounds.w);
+            height = std::max(height, bounds.h);
+        }
+    }
+
+    framebuffer = SDL_CreateRGBSurfaceWithFormat(0, std::max(1, width), std::max(1, height), 32,
+                                                 SDL_PIXELFORMAT_ARGB8888);
+    if (!framebuffer) {
+        std::cerr << "Failed to create framebuffer! SDL Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetSurfaceBlendMode(framebuffer, SDL_BLENDMODE_NONE);
+
+    renderer = SDL_CreateSoftwareRenderer(framebuffer);
+    if (!renderer) {
+        std::cerr << "Failed to create software renderer! SDL Error: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(framebuffer);
+        framebuffer = nullptr;
+        return nullptr;
+    }
+
+    invalidateAll();
+    return renderer;
+}
+
+/**
+ * @brief Destroys the renderer and the framebuffer.
+ */
+void SoftwareCompositor::destroy() {
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+    if (framebuffer) {
+        SDL_FreeSurface(framebuffer);
+        framebuffer = nullptr;
+    }
+    damage.clear();
+    presenting.clear();
+}
+
+/**
+ * @brief Returns true if a view of the given size fits the framebuffer.
+ */
+bool SoftwareCompositor::fits(int width, int height) const {
+    return framebuffer && width <= framebuffer->w && height <= framebuffer->h;
+}
+
+/**
+ * @brief Returns the window's size in pixels.
+ */
+void SoftwareCompositor::getViewSize(SDL_Window* window, int& width, int& height) {
+    SDL_Surface* surface = SDL_GetWindowSurface(window);
+    if (surface) {
+        width = surface->w;
+        height = surface->h;
+    } else {
+        SDL_GetWindowSize(window, &width, &height);
+    }
+}
+
+/**
+ * @brief Marks the whole view as needing a redraw.
+ */
+void SoftwareCompositor::invalidateAll() {
+    fullDamage = true;
+    damage.assign(1, SDL_Rect{0, 0, SDL_MAX_SINT32 / 2, SDL_MAX_SINT32 / 2});
+}
+
+/**
+ * @brief Marks a rectangle as needing a redraw, merging it with any it overlaps.
+ */
+void SoftwareCompositor::invalidate(const SDL_Rect& rect) {
+    if (fullDamage && !damage.empty()) return;
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    SDL_Rect merged = rect;
+    for (size_t i = 0; i < damage.size();) {
+        if (SDL_HasIntersection(&damage[i], &merged)) {
+            SDL_UnionRect(&damage[i], &merged, &merged);
+            damage.erase(damage.begin() + i);
+            i = 0;  // The grown rectangle may now reach earlier ones
+        } else {
+            ++i;
+        }
+    }
+    damage.push_back(merged);
+
+    // Many scattered rectangles cost more in per-rect overhead than one bounding box
+    if (damage.size() > MAX_DAMAGE_RECTS) {
+        SDL_Rect bounds = damage[0];
+        for (const SDL_Rect& r : damage) {
+            SDL_UnionRect(&bounds, &r, &bounds);
+        }
+        damage.assign(1, bounds);
+    }
+}
+
+/**
+ * @brief Clips the renderer and framebuffer to the damage of this frame.
+ * @return The clip rectangle, empty if nothing visible changed.
+ */
+SDL_Rect SoftwareCompositor::beginFrame(int width, int height) {
+    viewWidth = std::min(width, framebuffer ? framebuffer->w : 0);
+    viewHeight = std::min(height, framebuffer ? framebuffer->h : 0);
+
+    const SDL_Rect view = {0, 0, viewWidth, viewHeight};
+    presenting.clear();
+    clip = {0, 0, 0, 0};
+    for (const SDL_Rect& rect : damage) {
+        SDL_Rect visible;
+        if (SDL_IntersectRect(&rect, &view, &visible)) {
+            presenting.push_back(visible);
+            if (clip.w == 0) {
+                clip = visible;
+            } else {
+                SDL_UnionRect(&clip, &visible, &clip);
+            }
+        }
+    }
+
+    // An empty clip rect would disable clipping, so callers skip drawing instead
+    if (clip.w > 0) {
+        SDL_RenderSetClipRect(renderer, &clip);
+        SDL_SetClipRect(framebuffer, &clip);
+    }
+    return clip;
+}
+
+/**
+ * @brief Copies the damaged rectangles to the window and clears the damage.
+ * @return false if the window surface could not be updated.
+ */
+bool SoftwareCompositor::present(SDL_Window* window) {
+    presentedPixels = 0;
+    std::vector<SDL_Rect>& rects = presenting;  // Compacted in place to what reached the window
+    damage.clear();
+    fullDamage = false;
+    if (rects.empty()) {
+        return true;
+    }
+
+    SDL_Surface* target = SDL_GetWindowSurface(window);
+    if (!target) {
+        std::cerr << "Failed to get window surface! SDL Error: " << SDL_GetError() << std::endl;
+        invalidateAll();
+        return false;
+    }
+
+    // Window surfaces are normally XRGB8888, which shares the framebuffer's layout
+    const bool sameLayout = target->format->BytesPerPixel == 4 && target->format->Rmask == 0x00FF0000 &&
+                            target->format->Gmask == 0x0000FF00 && target->format->Bmask == 0x000000FF;
+    const SDL_Rect bounds = {0, 0, target->w, target->h};
+
+    size_t count = 0;
+    for (const SDL_Rect& rect : rects) {
+        SDL_Rect visible;
+        if (!SDL_IntersectRect(&rect, &bounds, &visible)) continue;
+
+        if (sameLayout && !SDL_MUSTLOCK(target)) {
+            const Uint8* src = static_cast<const Uint8*>(framebuffer->pixels) +
+                               visible.y * framebuffer->pitch + visible.x * 4;
+            Uint8* dst = static_cast<Uint8*>(target->pixels) + visible.y * target->pitch + visible.x * 4;
+            for (int y = 0; y < visible.h; ++y) {
+                std::memcpy(dst + y * target->pitch, src + y * framebuffer->pitch, static_cast<size_t>(visible.w) * 4);
+            }
+        } else {
+            SDL_Rect dstRect = visible;
+            SDL_BlitSurface(framebuffer, &visible, target, &dstRect);
+        }
+        rects[count++] = visible;
+        presentedPixels += static_cast<size_t>(visible.w) * visible.h;
+    }
+
+    bool ok = count == 0 || SDL_UpdateWindowSurfaceRects(window, rects.data(), static_cast<int>(count)) == 0;
+    rects.clear();
+    if (!ok) {
+        // The window lost its surface, e.g. during a resize; send everything next time
+        invalidateAll();
+    }
+    return ok;
+}
+
+/**
+ * @brief Blends a solid color over a rectangle of the framebuffer, within the clip rect.
+ */
+void SoftwareCompositor::fillBlend(const SDL_Rect& rect, const SDL_Color& color) {
+    SDL_Rect visible;
+    if (!framebuffer || color.a == 0 || !SDL_IntersectRect(&rect, &clip, &visible)) return;
+
+    const Uint32 rgb = (static_cast<Uint32>(color.r) << 16) | (static_cast<Uint32>(color.g) << 8) | color.b;
+    if (color.a == 255) {
+        SDL_FillRect(framebuffer, &visible, ALPHA_MASK | rgb);
+        return;
+    }
+
+    const Uint32 alpha = color.a;
+    const Uint32 inverse = 255 - alpha;
+#ifdef RETRO_HAVE_SSE2
+    // Source terms are the same for every pixel, so only the destination is multiplied
+    const __m128i zero = _mm_setzero_si128();
+    const short r = static_cast<short>(color.r * alpha);
+    const short g = static_cast<short>(color.g * alpha);
+    const short b = static_cast<short>(color.b * alpha);
+    const __m128i source = _mm_set_epi16(0, r, g, b, 0, r, g, b);
+    const __m128i inverseLanes = _mm_set1_epi16(static_cast<short>(inverse));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(ALPHA_MASK));
+#endif
+
+    for (int y = 0; y < visible.h; ++y) {
+        Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(framebuffer->pixels) +
+                                                (visible.y + y) * framebuffer->pitch) + visible.x;
+        int x = 0;
+#ifdef RETRO_HAVE_SSE2
+        for (; x + 4 <= visible.w; x += 4) {
+            __m128i* out = reinterpret_cast<__m128i*>(row + x);
+            __m128i d = _mm_loadu_si128(out);
+            __m128i lo = _mm_add_epi16(source, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverseLanes));
+            __m128i hi = _mm_add_epi16(source, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverseLanes));
+            _mm_storeu_si128(out, _mm_or_si128(_mm_packus_epi16(div255x8(lo), div255x8(hi)), alphaMask));
+        }
+#endif
+        for (; x < visible.w; ++x) {
+            Uint32 d = row[x];
+            Uint32 r = div255(color.r * alpha + ((d >> 16) & 0xFF) * inverse);
+            Uint32 g = div255(color.g * alpha + ((d >> 8) & 0xFF) * inverse);
+            Uint32 b = div255(color.b * alpha + (d & 0xFF) * inverse);
+            row[x] = ALPHA_MASK | (r << 16) | (g << 8) | b;
+        }
+    }
+}
+
+/**
+ * @brief Draws part of an ARGB8888 surface scaled to a rectangle, within the clip rect.
+ */
+void SoftwareCompositor::blitScaled(const SDL_Surface* source, const SDL_Rect& srcRect, const SDL_Rect& dstRect,
+                                    bool opaque) {
+    SDL_Rect visible;
+    if (!framebuffer || dstRect.w <= 0 || dstRect.h <= 0 || !SDL_IntersectRect(&dstRect, &clip, &visible)) return;
+
+    // Sample at destination pixel centres
+    columnMap.resize(visible.w);
+    for (int x = 0; x < visible.w; ++x) {
+        int dx = visible.x + x - dstRect.x;
+        columnMap[x] = srcRect.x + std::min(srcRect.w - 1, ((2 * dx + 1) * srcRect.w) / (2 * dstRect.w));
+    }
+    const bool unscaled = srcRect.w == dstRect.w;
+    const int firstColumn = columnMap[0];
+
+    for (int y = 0; y < visible.h; ++y) {
+        int dy = visible.y + y - dstRect.y;
+        int sy = srcRect.y + std::min(srcRect.h - 1, ((2 * dy + 1) * srcRect.h) / (2 * dstRect.h));
+        const Uint32* in = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(source->pixels) +
+                                                           sy * source->pitch);
+        Uint32* out = reinterpret_cast<Uint32*>(static_cast<Uint8*>(framebuffer->pixels) +
+                                                (visible.y + y) * framebuffer->pitch) + visible.x;
+
+        if (unscaled) {
+            if (opaque) {
+                std::memcpy(out, in + firstColumn, static_cast<size_t>(visible.w) * 4);
+            } else {
+                blendRow(in + firstColumn, out, visible.w);
+            }
+        } else if (opaque) {
+            for (int x = 0; x < visible.w; ++x) {
+                out[x] = in[columnMap[x]];
+            }
+        } else {
+            // Gather the sampled pixels first so the blend runs four at a time
+            gathered.resize(visible.w);
+            for (int x = 0; x < visible.w; ++x) {
+                gathered[x] = in[columnMap[x]];
+            }
+            blendRow(gathered.data(), out, visible.w);
+        }
+    }
+}
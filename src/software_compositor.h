@@ -0,0 +1,129 @@
+/**
+ * @file software_compositor.h
+ * @brief Declares SoftwareCompositor, the CPU rendering path for machines without a GPU.
+ *
+ * The launcher draws into one ARGB8888 framebuffer through SDL's software
+ * renderer. Only the rectangles that changed since the last frame are
+ * redrawn (everything else is clipped away) and copied to the window, so a
+ * moving selection or an arriving cover costs a few rows of pixels instead
+ * of a full screen. Covers and translucent panels bypass the renderer and
+ * are blended with SSE2 when available.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class SoftwareCompositor
+ * @brief Owns the framebuffer and software renderer and tracks damaged rectangles.
+ */
+class SoftwareCompositor {
+public:
+    SoftwareCompositor();
+    ~SoftwareCompositor();
+
+    SoftwareCompositor(const SoftwareCompositor&) = delete;
+    SoftwareCompositor& operator=(const SoftwareCompositor&) = delete;
+
+    /**
+     * @brief Creates the framebuffer and a software renderer that draws into it.
+     *
+     * The framebuffer is sized for the largest display, so resizing and
+     * fullscreen normally keep the renderer and every texture it owns.
+     *
+     * @param window The window frames are presented to.
+     * @param viewOnly Size the framebuffer to the window instead, e.g. while hibernating.
+     * @return The renderer, or nullptr on failure.
+     */
+    SDL_Renderer* create(SDL_Window* window, bool viewOnly = false);
+
+    /**
+     * @brief Destroys the renderer and the framebuffer.
+     */
+    void destroy();
+
+    /**
+     * @brief Returns true if a view of the given size fits the framebuffer.
+     */
+    bool fits(int width, int height) const;
+
+    SDL_Renderer* getRenderer() const { return renderer; }
+    SDL_Surface* getFramebuffer() const { return framebuffer; }
+
+    /**
+     * @brief Returns the window's size in pixels, the size of the view to draw.
+     */
+    static void getViewSize(SDL_Window* window, int& width, int& height);
+
+    /**
+     * @brief Marks the whole view as needing a redraw.
+     */
+    void invalidateAll();
+
+    /**
+     * @brief Marks a rectangle as needing a redraw. Overlapping rectangles merge.
+     */
+    void invalidate(const SDL_Rect& rect);
+
+    /**
+     * @brief Returns true if anything must be redrawn this frame.
+     */
+    bool hasDamage() const { return !damage.empty(); }
+
+    /**
+     * @brief Clips the renderer and framebuffer to the damage of this frame.
+     *
+     * Must be called after all invalidations of the frame and before drawing.
+     *
+     * @param width Width of the view in pixels.
+     * @param height Height of the view in pixels.
+     * @return The clip rectangle; drawing outside it has no effect.
+     */
+    SDL_Rect beginFrame(int width, int height);
+
+    /**
+     * @brief Copies the damaged rectangles to the window and clears the damage.
+     * @return false if the window surface could not be updated.
+     */
+    bool present(SDL_Window* window);
+
+    /**
+     * @brief Returns the number of pixels copied to the window by the last present().
+     */
+    size_t getPresentedPixels() const { return presentedPixels; }
+
+    /**
+     * @brief Blends a solid color over a rectangle of the framebuffer, within its clip rect.
+     */
+    void fillBlend(const SDL_Rect& rect, const SDL_Color& color);
+
+    /**
+     * @brief Draws part of an ARGB8888 surface scaled to a rectangle, within the clip rect.
+     *
+     * Sampling is nearest-neighbour, which matches what the software
+     * renderer does for textures.
+     *
+     * @param source Surface to read from.
+     * @param srcRect Region of the source.
+     * @param dstRect Destination in the framebuffer.
+     * @param opaque True if every source pixel has full alpha, so blending can be skipped.
+     */
+    void blitScaled(const SDL_Surface* source, const SDL_Rect& srcRect, const SDL_Rect& dstRect, bool opaque);
+
+private:
+    static const size_t MAX_DAMAGE_RECTS = 16;
+
+    SDL_Surface* framebuffer;
+    SDL_Renderer* renderer;
+    int viewWidth;
+    int viewHeight;
+    SDL_Rect clip;                     ///< Bounds of this frame's damage; direct blits stay inside it.
+    bool fullDamage;
+    std::vector<SDL_Rect> damage;
+    std::vector<SDL_Rect> presenting;  ///< Damage of the frame being drawn, clipped to the view.
+    std::vector<int> columnMap;        ///< Source column of each destination column, reused per blit.
+    std::vector<Uint32> gathered;      ///< Sampled source row awaiting blending, reused per blit.
+    size_t presentedPixels;
+};
@@ -0,0 +1,234 @@
+/**
+ * @file startup_graph.cpp
+ * @brief Implements StartupGraph scheduling and reporting.
+ */
+
+#include "startup_graph.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+/// Startup tasks mostly block on disk or network, so each may get its own thread
+const size_t MAX_WORKERS = 8;
+
+const char* statusName(StartupGraph::Status status) {
+    switch (status) {
+        case StartupGraph::Status::Succeeded: return "ok";
+        case StartupGraph::Status::Failed: return "failed";
+        case StartupGraph::Status::Skipped: return "skipped";
+        default: return "pending";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Registers a task.
+ */
+StartupGraph::TaskId StartupGraph::add(const std::string& name, std::function<bool()> work,
+                                       const std::vector<TaskId>& dependencies, Affinity affinity) {
+    TaskId id = tasks.size();
+    Task task;
+    task.work = std::move(work);
+    task.report = {name, affinity, Status::Pending, 0.0, 0.0};
+    for (TaskId dependency : dependencies) {
+        if (dependency < id) {  // Only earlier tasks, so the graph cannot have cycles
+            task.dependencies.push_back(dependency);
+        }
+    }
+    tasks.push_back(std::move(task));
+    for (TaskId dependency : tasks[id].dependencies) {
+        tasks[dependency].dependents.push_back(id);
+    }
+    return id;
+}
+
+/**
+ * @brief Runs every task, returning once all have finished or been skipped.
+ *
+ * Worker tasks are taken by a pool of threads; main-thread tasks are run
+ * by the caller between waits. A failed task marks everything that
+ * depends on it, directly or not, as skipped.
+ */
+bool StartupGraph::run() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    auto now = [start]() { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<TaskId> readyWorker;
+    std::deque<TaskId> readyMain;
+    size_t finished = 0;
+
+    auto makeReady = [&](TaskId id) {
+        (tasks[id].report.affinity == Affinity::Main ? readyMain : readyWorker).push_back(id);
+    };
+
+    // Called with the mutex held
+    std::function<void(TaskId, Status, double)> finish = [&](TaskId id, Status status, double endMs) {
+        tasks[id].report.status = status;
+        tasks[id].report.endMs = endMs;
+        finished++;
+        for (TaskId dependent : tasks[id].dependents) {
+            Task& next = tasks[dependent];
+            if (status != Status::Succeeded) {
+                if (next.report.status == Status::Pending) {
+                    next.report.startMs = endMs;
+                    finish(dependent, Status::Skipped, endMs);
+                }
+            } else if (--next.waitingOn == 0 && next.report.status == Status::Pending) {
+                makeReady(dependent);
+            }
+        }
+    };
+
+    auto execute = [&](TaskId id) {
+        double startMs = now();
+        bool ok = false;
+        try {
+            ok = tasks[id].work();
+        } catch (const std::exception& e) {
+            std::cerr << "Startup task " << tasks[id].report.name << " threw: " << e.what() << std::endl;
+        }
+        double endMs = now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks[id].report.startMs = startMs;
+        finish(id, ok ? Status::Succeeded : Status::Failed, endMs);
+        changed.notify_all();
+    };
+
+    size_t workerTasks = 0;
+    for (TaskId id = 0; id < tasks.size(); ++id) {
+        Task& task = tasks[id];
+        task.waitingOn = task.dependencies.size();
+        task.report.status = Status::Pending;
+        if (task.report.affinity == Affinity::Worker) {
+            workerTasks++;
+        }
+        if (task.waitingOn == 0) {
+            makeReady(id);
+        }
+    }
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < std::min(workerTasks, MAX_WORKERS); ++i) {
+        workers.emplace_back([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                changed.wait(lock, [&]() { return !readyWorker.empty() || finished == tasks.size(); });
+                if (readyWorker.empty()) {
+                    return;
+                }
+                TaskId id = readyWorker.front();
+                readyWorker.pop_front();
+                lock.unlock();
+                execute(id);
+                lock.lock();
+            }
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            changed.wait(lock, [&]() { return !readyMain.empty() || finished == tasks.size(); });
+            if (readyMain.empty()) {
+                break;
+            }
+            TaskId id = readyMain.front();
+            readyMain.pop_front();
+            lock.unlock();
+            execute(id);
+            lock.lock();
+        }
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    elapsedMs = now();
+
+    return std::all_of(tasks.begin(), tasks.end(),
+                       [](const Task& task) { return task.report.status == Status::Succeeded; });
+}
+
+/**
+ * @brief Returns the outcome and timing of every task, in registration order.
+ */
+std::vector<StartupGraph::TaskReport> StartupGraph::getReports() const {
+    std::vector<TaskReport> reports;
+    reports.reserve(tasks.size());
+    for (const Task& task : tasks) {
+        reports.push_back(task.report);
+    }
+    return reports;
+}
+
+/**
+ * @brief Returns the chain of tasks that determined when startup finished.
+ */
+std::vector<StartupGraph::TaskId> StartupGraph::criticalPath() const {
+    std::vector<TaskId> path;
+    if (tasks.empty()) {
+        return path;
+    }
+
+    auto laterEnd = [this](TaskId a, TaskId b) { return tasks[a].report.endMs < tasks[b].report.endMs; };
+    TaskId current = 0;
+    for (TaskId id = 1; id < tasks.size(); ++id) {
+        if (laterEnd(current, id)) current = id;
+    }
+
+    while (true) {
+        path.push_back(current);
+        const std::vector<TaskId>& dependencies = tasks[current].dependencies;
+        if (dependencies.empty()) {
+            break;
+        }
+        current = *std::max_element(dependencies.begin(), dependencies.end(), laterEnd);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+/**
+ * @brief Prints per-task timings and the critical path.
+ */
+void StartupGraph::printReport(std::ostream& out, const std::string& title) const {
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    double busyMs = 0.0;
+    out << title << ": " << std::fixed << std::setprecision(1) << elapsedMs << " ms" << std::endl;
+    for (const Task& task : tasks) {
+        const TaskReport& report = task.report;
+        busyMs += report.durationMs();
+        out << "  " << std::left << std::setw(12) << report.name << std::right
+            << std::setw(8) << report.startMs << " -> " << std::setw(8) << report.endMs << " ms  ("
+            << std::setw(7) << report.durationMs() << " ms, "
+            << (report.affinity == Affinity::Main ? "main" : "worker") << ", " << statusName(report.status) << ")"
+            << std::endl;
+    }
+
+    out << "  critical path:";
+    const char* separator = " ";
+    for (TaskId id : criticalPath()) {
+        out << separator << tasks[id].report.name << " (" << tasks[id].report.durationMs() << " ms)";
+        separator = " -> ";
+    }
+    out << std::endl;
+    if (elapsedMs > 0.0) {
+        out << "  " << busyMs << " ms of work in " << elapsedMs << " ms (" << busyMs / elapsedMs << "x overlap)" << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
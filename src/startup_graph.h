@@ -0,0 +1,109 @@
+/**
+ * @file startup_graph.h
+ * @brief Declares StartupGraph, which runs independent startup tasks concurrently.
+ *
+ * Startup is a handful of slow steps: mapping assets and opening the
+ * font, creating the window and renderer, authenticating with Twitch,
+ * scanning the ROM directory and fetching metadata. Most do not depend on
+ * each other. Each step is registered with the steps it needs. A task
+ * starts as soon as its dependencies finish, on a worker thread or, for
+ * SDL video calls, on the thread that called run(). Every task is timed
+ * so the report can show where startup time goes and which chain of
+ * tasks bounded it.
+ */
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @class StartupGraph
+ * @brief A small dependency graph of init tasks with per-task timings.
+ */
+class StartupGraph {
+public:
+    using TaskId = size_t;
+
+    /// Where a task runs
+    enum class Affinity {
+        Worker,  ///< Any worker thread.
+        Main     ///< The thread that calls run(), e.g. for window creation.
+    };
+
+    /// Outcome of a task after run()
+    enum class Status { Pending, Succeeded, Failed, Skipped };
+
+    /**
+     * @brief Timing and outcome of one task, in milliseconds since run() started.
+     */
+    struct TaskReport {
+        std::string name;
+        Affinity affinity;
+        Status status;
+        double startMs;
+        double endMs;
+        double durationMs() const { return endMs - startMs; }
+    };
+
+    /**
+     * @brief Registers a task.
+     * @param name Label used in the report.
+     * @param work The task; returns false on failure. Exceptions count as failures.
+     * @param dependencies Tasks that must succeed first. If one fails, this task is skipped.
+     * @param affinity Where the task must run.
+     * @return The id of the task, for use as a dependency.
+     */
+    TaskId add(const std::string& name, std::function<bool()> work,
+               const std::vector<TaskId>& dependencies = {}, Affinity affinity = Affinity::Worker);
+
+    /**
+     * @brief Runs every task, returning once all have finished or been skipped.
+     * @return true if every task succeeded.
+     */
+    bool run();
+
+    /**
+     * @brief Returns true if the task ran and succeeded.
+     */
+    bool succeeded(TaskId task) const { return tasks[task].report.status == Status::Succeeded; }
+
+    /**
+     * @brief Returns the outcome and timing of every task, in registration order.
+     */
+    std::vector<TaskReport> getReports() const;
+
+    /**
+     * @brief Returns the chain of tasks that determined when startup finished.
+     *
+     * Starting from the task that finished last, each step goes to the
+     * dependency that finished last. Shortening any other task would not
+     * have made startup finish sooner.
+     */
+    std::vector<TaskId> criticalPath() const;
+
+    /**
+     * @brief Returns the wall time of the last run() in milliseconds.
+     */
+    double getElapsedMs() const { return elapsedMs; }
+
+    /**
+     * @brief Prints per-task timings and the critical path.
+     * @param title Names the graph in the report's first line.
+     */
+    void printReport(std::ostream& out, const std::string& title = "Startup") const;
+
+private:
+    struct Task {
+        std::function<bool()> work;
+        std::vector<TaskId> dependencies;
+        std::vector<TaskId> dependents;
+        size_t waitingOn = 0;
+        TaskReport report;
+    };
+
+    std::vector<Task> tasks;
+    double elapsedMs = 0.0;
+};
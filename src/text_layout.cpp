@@ -0,0 +1,171 @@
+/**
+ * @file text_layout.cpp
+ * @brief Implements paragraph wrapping and the TextLayoutCache.
+ */
+
+#include "text_layout.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+const int LINK_PADDING = 10;  ///< Minimum gap kept free in front of a trailing link.
+const int LINK_OFFSET = 5;    ///< Gap between the last word and the link.
+
+/**
+ * @brief Measures how many bytes of text starting at offset fit in width pixels.
+ * @return The number of bytes that fit, or 0 if nothing does.
+ */
+int fittingBytes(TTF_Font* font, const std::string& text, size_t offset, int width) {
+    int extent = 0;
+    int count = 0;
+    if (width <= 0 || TTF_MeasureText(font, text.c_str() + offset, width, &extent, &count) != 0) {
+        return 0;
+    }
+    return count;
+}
+
+/**
+ * @brief Measures the pixel width of a range of text.
+ */
+int measureRange(TTF_Font* font, const std::string& text, size_t offset, size_t length) {
+    int w = 0, h = 0;
+    std::string line = text.substr(offset, length);
+    TTF_SizeText(font, line.c_str(), &w, &h);
+    return w;
+}
+
+/**
+ * @brief Picks the end of a line that must fit within fitBytes bytes.
+ *
+ * Breaks at an explicit newline, otherwise at the last space that fits, and
+ * only splits a word when it is wider than the whole line.
+ *
+ * @return Length of the line in bytes. The separator is not included.
+ */
+size_t breakLine(const std::string& text, size_t offset, size_t fitBytes) {
+    size_t limit = std::min(text.size(), offset + fitBytes);
+    size_t newline = text.find('\n', offset);
+    if (newline != std::string::npos && newline < limit) {
+        return newline - offset;
+    }
+    if (limit >= text.size()) {
+        return text.size() - offset;
+    }
+    // The character right after the fitting range may itself be the break
+    if (text[limit] == ' ') {
+        return limit - offset;
+    }
+    size_t space = text.find_last_of(' ', limit);
+    if (space != std::string::npos && space > offset) {
+        return space - offset;
+    }
+    return std::max<size_t>(1, fitBytes);
+}
+
+} // namespace
+
+/**
+ * @brief Hashes a layout key.
+ */
+size_t TextLayoutCache::KeyHash::operator()(const Key& key) const {
+    size_t h = key.textHash;
+    h ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()(key.width) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()((key.maxLines << 16) ^ (key.lineHeight << 1) ^ key.hasLink) +
+         0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+/**
+ * @brief Returns the layout for a paragraph, computing it on first use.
+ * @param text The paragraph text.
+ * @param font Font used for measurement.
+ * @param width Available width in pixels.
+ * @param maxLines Maximum number of lines to lay out.
+ * @param lineHeight Distance between baselines, used for the link rect.
+ * @param linkText Text of a trailing link, or empty for none.
+ * @return Reference to the cached layout.
+ */
+const TextLayout& TextLayoutCache::get(const std::string& text, TTF_Font* font, int width, int maxLines,
+                                       int lineHeight, const std::string& linkText) {
+    Key key{std::hash<std::string>()(text), font, width, maxLines, lineHeight, !linkText.empty()};
+
+    auto it = layouts.find(key);
+    if (it != layouts.end() && it->second.text == text) {
+        return it->second.layout;
+    }
+
+    if (layouts.size() >= MAX_ENTRIES) {
+        layouts.clear();
+    }
+
+    Entry& entry = layouts[key];
+    entry.text = text;
+    entry.layout = compute(text, font, width, maxLines, lineHeight, linkText);
+    computeCount++;
+    return entry.layout;
+}
+
+/**
+ * @brief Drops all cached layouts.
+ */
+void TextLayoutCache::clear() {
+    layouts.clear();
+}
+
+/**
+ * @brief Wraps a paragraph into at most maxLines lines.
+ *
+ * Each line costs one TTF_MeasureText call to find how much fits, plus one
+ * TTF_SizeText call for its final width. When a trailing link is requested,
+ * the last line is re-fitted once against the width left beside the link.
+ */
+TextLayout TextLayoutCache::compute(const std::string& text, TTF_Font* font, int width, int maxLines,
+                                    int lineHeight, const std::string& linkText) {
+    TextLayout layout;
+    if (!font || text.empty() || width <= 0 || maxLines <= 0) {
+        return layout;
+    }
+
+    int linkWidth = 0;
+    int linkHeight = 0;
+    if (!linkText.empty()) {
+        TTF_SizeText(font, linkText.c_str(), &linkWidth, &linkHeight);
+    }
+
+    size_t offset = 0;
+    while (offset < text.size() && static_cast<int>(layout.lines.size()) < maxLines) {
+        int fit = fittingBytes(font, text, offset, width);
+        size_t length = breakLine(text, offset, std::max(1, fit));
+        bool lastLine = static_cast<int>(layout.lines.size()) == maxLines - 1 ||
+                        offset + length >= text.size();
+
+        int lineWidth = measureRange(font, text, offset, length);
+        if (lastLine && !linkText.empty() && lineWidth + linkWidth + LINK_PADDING > width) {
+            // Shorten the last line so the link fits beside it
+            int linkFit = fittingBytes(font, text, offset, width - linkWidth - LINK_PADDING);
+            length = linkFit > 0 ? breakLine(text, offset, linkFit) : 0;
+            lineWidth = length > 0 ? measureRange(font, text, offset, length) : 0;
+        }
+
+        layout.lines.push_back({offset, length, lineWidth, text.substr(offset, length)});
+        offset += length;
+        if (offset < text.size() && (text[offset] == ' ' || text[offset] == '\n')) {
+            offset++;  // Skip the separator
+        }
+
+        if (lastLine) {
+            break;
+        }
+    }
+
+    if (!linkText.empty() && !layout.lines.empty()) {
+        const TextLine& last = layout.lines.back();
+        int row = static_cast<int>(layout.lines.size()) - 1;
+        layout.hasLink = true;
+        layout.linkRect = {last.width + LINK_OFFSET, row * lineHeight, linkWidth, linkHeight};
+    }
+
+    return layout;
+}
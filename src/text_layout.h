@@ -0,0 +1,102 @@
+/**
+ * @file text_layout.h
+ * @brief Declares the TextLayoutCache class for caching wrapped paragraph layouts.
+ *
+ * Wrapping a paragraph needs several font measurements. A layout only
+ * depends on the text, font, width, line limit and optional trailing link,
+ * so it is computed once and replayed every frame.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A single wrapped line, stored as a range of the source text.
+ *
+ * The line's own text is kept too, so drawing it every frame does not need
+ * to copy it out of the paragraph again.
+ */
+struct TextLine {
+    size_t offset;     ///< Byte offset of the line in the source text.
+    size_t length;     ///< Number of bytes in the line.
+    int width;         ///< Rendered width of the line in pixels.
+    std::string text;  ///< Text of the line, copied out once when it is wrapped.
+};
+
+/**
+ * @brief The computed layout of a paragraph.
+ */
+struct TextLayout {
+    std::vector<TextLine> lines;
+    bool hasLink = false;          ///< Whether a trailing link is shown.
+    SDL_Rect linkRect = {0, 0, 0, 0};  ///< Link hit-rect relative to the paragraph origin.
+};
+
+/**
+ * @class TextLayoutCache
+ * @brief Computes and caches line breaks and link placement for wrapped text.
+ */
+class TextLayoutCache {
+public:
+    /**
+     * @brief Returns the layout for a paragraph, computing it on first use.
+     *
+     * @param text The paragraph text.
+     * @param font Font used for measurement.
+     * @param width Available width in pixels.
+     * @param maxLines Maximum number of lines to lay out.
+     * @param lineHeight Distance between baselines, used for the link rect.
+     * @param linkText Text of a trailing link, or empty for none.
+     * @return Reference to the cached layout. Valid until the next call.
+     */
+    const TextLayout& get(const std::string& text, TTF_Font* font, int width, int maxLines,
+                          int lineHeight, const std::string& linkText);
+
+    /**
+     * @brief Drops all cached layouts, e.g. after the font changed.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of layouts computed since construction.
+     */
+    size_t getComputeCount() const { return computeCount; }
+
+private:
+    static const size_t MAX_ENTRIES = 4096;
+
+    struct Key {
+        size_t textHash;
+        TTF_Font* font;
+        int width;
+        int maxLines;
+        int lineHeight;
+        bool hasLink;
+
+        bool operator==(const Key& other) const {
+            return textHash == other.textHash && font == other.font && width == other.width &&
+                   maxLines == other.maxLines && lineHeight == other.lineHeight &&
+                   hasLink == other.hasLink;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::string text;  ///< Source text, compared on lookup to rule out hash collisions.
+        TextLayout layout;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> layouts;
+    size_t computeCount = 0;
+
+    static TextLayout compute(const std::string& text, TTF_Font* font, int width, int maxLines,
+                              int lineHeight, const std::string& linkText);
+};
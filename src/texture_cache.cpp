@@ -0,0 +1,132 @@
+/**
+ * @file texture_cache.cpp
+ * @brief Implements the byte-budgeted LRU TextureCache.
+ */
+
+#include "texture_cache.h"
+#include <iterator>
+
+/**
+ * @brief Constructs an empty cache with the given budget.
+ * @param budgetBytes Maximum estimated texture memory to keep resident.
+ */
+TextureCache::TextureCache(size_t budgetBytes) {
+    stats.budgetBytes = budgetBytes;
+}
+
+/**
+ * @brief Destroys every texture still owned by the cache.
+ */
+TextureCache::~TextureCache() {
+    clear();
+}
+
+/**
+ * @brief Looks up a texture and marks it as most recently used.
+ * @param key The cache key.
+ * @return The cached texture or nullptr on a miss.
+ */
+SDL_Texture* TextureCache::get(const std::string& key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    stats.hits++;
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->texture;
+}
+
+/**
+ * @brief Inserts a texture, taking ownership of it.
+ * @param key The cache key.
+ * @param texture The texture to cache.
+ */
+void TextureCache::put(const std::string& key, SDL_Texture* texture) {
+    if (!texture) return;
+
+    auto existing = index.find(key);
+    if (existing != index.end()) {
+        erase(existing->second);
+    }
+
+    size_t bytes = estimateTextureBytes(texture);
+    evictToFit(bytes);
+
+    lru.push_front({key, texture, bytes});
+    index[key] = lru.begin();
+    stats.residentBytes += bytes;
+    stats.entries = lru.size();
+}
+
+/**
+ * @brief Changes the byte budget, evicting immediately if it shrank.
+ * @param budgetBytes The new budget.
+ */
+void TextureCache::setBudget(size_t budgetBytes) {
+    stats.budgetBytes = budgetBytes;
+    evictToFit(0);
+}
+
+/**
+ * @brief Destroys all cached textures. Counters are kept.
+ */
+void TextureCache::clear() {
+    for (auto& entry : lru) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    lru.clear();
+    index.clear();
+    stats.residentBytes = 0;
+    stats.entries = 0;
+}
+
+/**
+ * @brief Returns a snapshot of the cache counters.
+ */
+TextureCacheStats TextureCache::getStats() const {
+    return stats;
+}
+
+/**
+ * @brief Estimates the GPU memory used by a texture from its size and format.
+ * @param texture The texture to measure.
+ * @return Estimated size in bytes.
+ */
+size_t TextureCache::estimateTextureBytes(SDL_Texture* texture) {
+    Uint32 format = 0;
+    int w = 0, h = 0;
+    if (SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) {
+        return 0;
+    }
+
+    size_t bytesPerPixel = SDL_BYTESPERPIXEL(format);
+    if (bytesPerPixel == 0) {
+        bytesPerPixel = 4;  // Packed/FourCC formats; assume 32-bit
+    }
+    return static_cast<size_t>(w) * static_cast<size_t>(h) * bytesPerPixel;
+}
+
+/**
+ * @brief Evicts least recently used textures until incomingBytes fits the budget.
+ * @param incomingBytes Size of the texture about to be inserted.
+ */
+void TextureCache::evictToFit(size_t incomingBytes) {
+    while (!lru.empty() && stats.residentBytes + incomingBytes > stats.budgetBytes) {
+        erase(std::prev(lru.end()));
+        stats.evictions++;
+    }
+}
+
+/**
+ * @brief Destroys a single entry and updates the bookkeeping.
+ * @param it Iterator to the entry in the LRU list.
+ */
+void TextureCache::erase(std::list<Entry>::iterator it) {
+    SDL_DestroyTexture(it->texture);
+    stats.residentBytes -= it->bytes;
+    index.erase(it->key);
+    lru.erase(it);
+    stats.entries = lru.size();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file texture_cache.h
+ * @brief Declares the TextureCache class, a byte-budgeted LRU cache of SDL textures.
+ *
+ * Cover art and rasterized text are cached as GPU textures. Both caches are
+ * bounded by a byte budget and evict the least recently used textures when
+ * an insertion would exceed it.
+ */
+
+#pragma once
+#include <SDL.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Counters describing how a TextureCache is performing.
+ */
+struct TextureCacheStats {
+    size_t hits = 0;           ///< Lookups that found a resident texture.
+    size_t misses = 0;         ///< Lookups that found nothing.
+    size_t evictions = 0;      ///< Textures destroyed to stay within budget.
+    size_t entries = 0;        ///< Textures currently resident.
+    size_t residentBytes = 0;  ///< Estimated GPU bytes currently resident.
+    size_t budgetBytes = 0;    ///< Configured byte budget.
+};
+
+/**
+ * @class TextureCache
+ * @brief Owns SDL textures keyed by string and evicts them in LRU order.
+ */
+class TextureCache {
+public:
+    /**
+     * @brief Constructs an empty cache.
+     * @param budgetBytes Maximum estimated texture memory to keep resident.
+     */
+    explicit TextureCache(size_t budgetBytes);
+
+    /**
+     * @brief Destroys every texture still owned by the cache.
+     */
+    ~TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    /**
+     * @brief Looks up a texture and marks it as most recently used.
+     * @param key The cache key.
+     * @return The cached texture or nullptr on a miss.
+     */
+    SDL_Texture* get(const std::string& key);
+
+    /**
+     * @brief Inserts a texture, taking ownership of it.
+     *
+     * Least recently used textures are destroyed until the new one fits. A
+     * texture larger than the whole budget is still kept so the current
+     * frame can draw it.
+     *
+     * @param key The cache key. An existing entry with this key is replaced.
+     * @param texture The texture to cache.
+     */
+    void put(const std::string& key, SDL_Texture* texture);
+
+    /**
+     * @brief Changes the byte budget, evicting immediately if it shrank.
+     * @param budgetBytes The new budget.
+     */
+    void setBudget(size_t budgetBytes);
+
+    /**
+     * @brief Destroys all cached textures. Counters are kept.
+     */
+    void clear();
+
+    /**
+     * @brief Returns a snapshot of the cache counters.
+     */
+    TextureCacheStats getStats() const;
+
+    /**
+     * @brief Estimates the GPU memory used by a texture from its size and format.
+     * @param texture The texture to measure.
+     * @return Estimated size in bytes.
+     */
+    static size_t estimateTextureBytes(SDL_Texture* texture);
+
+private:
+    struct Entry {
+        std::string key;
+        SDL_Texture* texture;
+        size_t bytes;
+    };
+
+    std::list<Entry> lru;  ///< Most recently used entries at the front.
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    TextureCacheStats stats;
+
+    void evictToFit(size_t incomingBytes);
+    void erase(std::list<Entry>::iterator it);
+};
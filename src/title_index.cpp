@@ -0,0 +1,351 @@
+/**
+ * @file title_index.cpp
+ * @brief Implements text folding and the n-gram backed TitleIndex.
+ */
+
+#include "title_index.h"
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+
+namespace {
+
+/**
+ * @brief Maps a range of code points to their folded ASCII spelling.
+ */
+struct FoldRange {
+    char32_t first;
+    char32_t last;
+    const char* folded;  ///< Empty to drop the character, " " to separate words.
+};
+
+// Latin-1 Supplement, Latin Extended-A and a few typographic marks
+const FoldRange FOLD_RANGES[] = {
+    {0x00C0, 0x00C5, "a"}, {0x00C6, 0x00C6, "ae"}, {0x00C7, 0x00C7, "c"}, {0x00C8, 0x00CB, "e"},
+    {0x00CC, 0x00CF, "i"}, {0x00D0, 0x00D0, "d"}, {0x00D1, 0x00D1, "n"}, {0x00D2, 0x00D6, "o"},
+    {0x00D7, 0x00D7, " "}, {0x00D8, 0x00D8, "o"}, {0x00D9, 0x00DC, "u"}, {0x00DD, 0x00DD, "y"},
+    {0x00DE, 0x00DE, "th"}, {0x00DF, 0x00DF, "ss"}, {0x00E0, 0x00E5, "a"}, {0x00E6, 0x00E6, "ae"},
+    {0x00E7, 0x00E7, "c"}, {0x00E8, 0x00EB, "e"}, {0x00EC, 0x00EF, "i"}, {0x00F0, 0x00F0, "d"},
+    {0x00F1, 0x00F1, "n"}, {0x00F2, 0x00F6, "o"}, {0x00F7, 0x00F7, " "}, {0x00F8, 0x00F8, "o"},
+    {0x00F9, 0x00FC, "u"}, {0x00FD, 0x00FD, "y"}, {0x00FE, 0x00FE, "th"}, {0x00FF, 0x00FF, "y"},
+    {0x0100, 0x0105, "a"}, {0x0106, 0x010D, "c"}, {0x010E, 0x0111, "d"}, {0x0112, 0x011B, "e"},
+    {0x011C, 0x0123, "g"}, {0x0124, 0x0127, "h"}, {0x0128, 0x0131, "i"}, {0x0132, 0x0133, "ij"},
+    {0x0134, 0x0135, "j"}, {0x0136, 0x0138, "k"}, {0x0139, 0x0142, "l"}, {0x0143, 0x014B, "n"},
+    {0x014C, 0x0151, "o"}, {0x0152, 0x0153, "oe"}, {0x0154, 0x0159, "r"}, {0x015A, 0x0161, "s"},
+    {0x0162, 0x0167, "t"}, {0x0168, 0x0173, "u"}, {0x0174, 0x0175, "w"}, {0x0176, 0x0178, "y"},
+    {0x0179, 0x017E, "z"}, {0x017F, 0x017F, "s"},
+    {0x2010, 0x2015, " "}, {0x2018, 0x2019, ""}, {0x201C, 0x201D, " "}, {0x2122, 0x2122, ""}
+};
+
+const std::vector<uint32_t> NO_MATCHES;
+
+/**
+ * @brief Returns the folded spelling of a code point, or nullptr to keep it as it is.
+ */
+const char* foldCodePoint(char32_t cp) {
+    for (const FoldRange& range : FOLD_RANGES) {
+        if (cp >= range.first && cp <= range.last) {
+            return range.folded;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Packs a 1-3 byte gram with its length so grams of different lengths never collide.
+ */
+uint32_t packGram(const char* p, size_t length) {
+    uint32_t code = static_cast<uint32_t>(length) << 24;
+    for (size_t k = 0; k < length; ++k) {
+        code |= static_cast<uint32_t>(static_cast<unsigned char>(p[k])) << (8 * (2 - k));
+    }
+    return code;
+}
+
+/**
+ * @brief Splits folded text into its space-separated terms.
+ */
+std::vector<std::string> splitTerms(const std::string& folded) {
+    std::vector<std::string> terms;
+    size_t start = 0;
+    while (start < folded.size()) {
+        size_t end = folded.find(' ', start);
+        if (end == std::string::npos) end = folded.size();
+        if (end > start) terms.push_back(folded.substr(start, end - start));
+        start = end + 1;
+    }
+    return terms;
+}
+
+} // namespace
+
+/**
+ * @brief Folds text for matching: ASCII lower case, Latin diacritics
+ *        stripped, apostrophes dropped and other punctuation turned into
+ *        single spaces.
+ *
+ * Characters outside the fold table are kept byte for byte, so titles in
+ * other scripts still match queries typed in them.
+ */
+std::string TitleIndex::fold(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    bool pendingSpace = false;
+
+    // Leading, trailing and repeated separators collapse away
+    auto put = [&](char c) {
+        if (c == ' ') {
+            pendingSpace = !out.empty();
+            return;
+        }
+        if (pendingSpace) {
+            out += ' ';
+            pendingSpace = false;
+        }
+        out += c;
+    };
+
+    for (size_t i = 0; i < text.size();) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            if (c >= 'A' && c <= 'Z') {
+                put(static_cast<char>(c - 'A' + 'a'));
+            } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                put(static_cast<char>(c));
+            } else if (c != '\'') {
+                put(' ');
+            }
+            ++i;
+            continue;
+        }
+
+        // Decode one UTF-8 sequence; stray bytes are skipped
+        size_t length = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 0;
+        if (length == 0 || i + length > text.size()) {
+            ++i;
+            continue;
+        }
+        char32_t cp = c & (0x3F >> (length - 1));
+        for (size_t k = 1; k < length; ++k) {
+            cp = (cp << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+        }
+
+        if (const char* folded = foldCodePoint(cp)) {
+            for (const char* f = folded; *f; ++f) put(*f);
+        } else {
+            for (size_t k = 0; k < length; ++k) put(text[i + k]);  // Kept verbatim
+        }
+        i += length;
+    }
+    return out;
+}
+
+/**
+ * @brief Rebuilds the index for a library; entries are referred to by GameId.
+ *
+ * Each entry's key is its folded title, followed by its folded filename
+ * stem when that differs. Every 1 to MAX_GRAM byte gram of a key that
+ * does not cross a space gets the entry in its postings.
+ */
+void TitleIndex::build(const GameCatalog& catalog) {
+    clear();
+    keyOffsets.reserve(catalog.size() + 1);
+    everything.reserve(catalog.size());
+
+    std::vector<uint32_t> entryGrams;
+    for (GameId entry = 0; entry < catalog.size(); ++entry) {
+        const std::string& filename = catalog.filename(entry);
+        std::string title = fold(catalog.title(entry));
+        std::string file = fold(filename.substr(0, filename.find_last_of('.')));
+        std::string key = title;
+        if (file != title) {
+            key += ' ';
+            key += file;
+        }
+
+        keyOffsets.push_back(static_cast<uint32_t>(keys.size()));
+        keys += key;
+        everything.push_back(entry);
+
+        int slot = title.empty() ? -1 : initialSlot(title[0]);
+        if (slot >= 0) {
+            initials[slot].push_back(entry);
+        }
+
+        // Query terms never contain spaces, so neither do indexed grams
+        entryGrams.clear();
+        for (size_t k = 0; k < key.size(); ++k) {
+            for (size_t length = 1; length <= MAX_GRAM && k + length <= key.size(); ++length) {
+                if (key[k + length - 1] == ' ') break;
+                entryGrams.push_back(packGram(key.data() + k, length));
+            }
+        }
+        std::sort(entryGrams.begin(), entryGrams.end());
+        entryGrams.erase(std::unique(entryGrams.begin(), entryGrams.end()), entryGrams.end());
+        for (uint32_t gram : entryGrams) {
+            grams[gram].push_back(entry);
+        }
+    }
+    keyOffsets.push_back(static_cast<uint32_t>(keys.size()));
+}
+
+/**
+ * @brief Drops the index and the search history.
+ */
+void TitleIndex::clear() {
+    keys.clear();
+    keyOffsets.clear();
+    grams.clear();
+    for (auto& slot : initials) {
+        slot.clear();
+    }
+    everything.clear();
+    history.clear();
+    lastSearchMs = 0.0;
+}
+
+/**
+ * @brief Finds the entries matching a query.
+ *
+ * Typing usually extends the previous query, so its matches are kept in
+ * a short history and narrowed instead of searching the whole index
+ * again. Backspacing returns a step from the history unchanged.
+ *
+ * @param query Raw query text; it is folded before matching.
+ * @return Ascending entry positions. An empty query matches everything.
+ */
+const std::vector<uint32_t>& TitleIndex::search(const std::string& query) {
+    auto start = std::chrono::steady_clock::now();
+    auto finish = [&](const std::vector<uint32_t>& result) -> const std::vector<uint32_t>& {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        lastSearchMs = elapsed.count();
+        return result;
+    };
+
+    std::string folded = fold(query);
+    std::vector<std::string> terms = splitTerms(folded);
+    if (terms.empty()) {
+        history.clear();
+        return finish(everything);
+    }
+
+    // Keep only the steps this query extends; their matches are supersets of ours
+    while (!history.empty() && folded.compare(0, history.back().query.size(), history.back().query) != 0) {
+        history.pop_back();
+    }
+    if (!history.empty() && history.back().query == folded) {
+        return finish(history.back().matches);
+    }
+
+    Step step;
+    step.query = folded;
+    const std::vector<uint32_t>* postings = smallestPostings(terms);
+    if (terms.size() == 1 && terms[0].size() <= MAX_GRAM) {
+        // A single short term is a gram itself, so its postings are the answer
+        step.matches = *postings;
+    } else {
+        // Re-check whichever is smaller: the previous matches or one gram's postings
+        const std::vector<uint32_t>* pool = history.empty() ? &everything : &history.back().matches;
+        if (postings->size() < pool->size()) {
+            pool = postings;
+        }
+        for (uint32_t entry : *pool) {
+            if (matchesAll(entry, terms)) {
+                step.matches.push_back(entry);
+            }
+        }
+    }
+
+    if (history.size() >= MAX_HISTORY) {
+        history.erase(history.begin());
+    }
+    history.push_back(std::move(step));
+    return finish(history.back().matches);
+}
+
+/**
+ * @brief Returns the first entry whose title starts with a letter or digit, or -1.
+ */
+int TitleIndex::firstWithInitial(char initial) const {
+    int slot = initialSlot(initial);
+    if (slot < 0 || initials[slot].empty()) return -1;
+    return static_cast<int>(initials[slot].front());
+}
+
+/**
+ * @brief Returns the next entry after position whose title starts with initial,
+ *        wrapping around to the first one, or -1 if there is none.
+ */
+int TitleIndex::nextWithInitial(char initial, int position) const {
+    int slot = initialSlot(initial);
+    if (slot < 0 || initials[slot].empty()) return -1;
+
+    const std::vector<uint32_t>& entries = initials[slot];
+    auto it = position < 0 ? entries.begin()
+                           : std::upper_bound(entries.begin(), entries.end(), static_cast<uint32_t>(position));
+    return static_cast<int>(it == entries.end() ? entries.front() : *it);
+}
+
+/**
+ * @brief Returns the approximate heap footprint of the index in bytes.
+ */
+size_t TitleIndex::memoryBytes() const {
+    size_t bytes = keys.capacity() + (keyOffsets.capacity() + everything.capacity()) * sizeof(uint32_t);
+    for (const auto& postings : grams) {
+        // Rough per-node overhead of the hash map plus the postings themselves
+        bytes += 48 + postings.second.capacity() * sizeof(uint32_t);
+    }
+    for (const auto& slot : initials) {
+        bytes += slot.capacity() * sizeof(uint32_t);
+    }
+    for (const Step& step : history) {
+        bytes += step.query.capacity() + step.matches.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Returns the jump table slot of a letter or digit: 0-25 for a-z, 26-35 for 0-9, else -1.
+ */
+int TitleIndex::initialSlot(char c) {
+    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= '0' && c <= '9') return 26 + (c - '0');
+    return -1;
+}
+
+/**
+ * @brief Returns true if an entry's key contains every term.
+ */
+bool TitleIndex::matchesAll(uint32_t entry, const std::vector<std::string>& terms) const {
+    std::string_view key(keys.data() + keyOffsets[entry], keyOffsets[entry + 1] - keyOffsets[entry]);
+    for (const std::string& term : terms) {
+        if (key.find(term) == std::string_view::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the shortest postings list among the grams of all terms.
+ *
+ * Terms up to MAX_GRAM bytes are looked up whole; longer ones by each of
+ * their trigrams. A gram that was never indexed means nothing can match.
+ */
+const std::vector<uint32_t>* TitleIndex::smallestPostings(const std::vector<std::string>& terms) const {
+    const std::vector<uint32_t>* best = nullptr;
+    for (const std::string& term : terms) {
+        size_t length = std::min(term.size(), MAX_GRAM);
+        for (size_t k = 0; k + length <= term.size(); ++k) {
+            auto it = grams.find(packGram(term.data() + k, length));
+            if (it == grams.end()) {
+                return &NO_MATCHES;
+            }
+            if (!best || it->second.size() < best->size()) {
+                best = &it->second;
+            }
+        }
+    }
+    return best;
+}
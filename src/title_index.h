@@ -0,0 +1,100 @@
+/**
+ * @file title_index.h
+ * @brief Declares the TitleIndex class for incremental type-to-search over the library.
+ *
+ * Titles and filenames are folded (lower case, diacritics stripped,
+ * punctuation collapsed to spaces) and indexed by byte grams of one to
+ * three bytes. A query matches an entry when every space-separated term
+ * occurs somewhere in its folded text. Results of earlier keystrokes are kept, so extending a query
+ * only re-checks the previous matches and deleting a character is a lookup.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "game_catalog.h"
+
+/**
+ * @class TitleIndex
+ * @brief N-gram index over game titles and filenames with an initial-letter jump table.
+ */
+class TitleIndex {
+public:
+    /**
+     * @brief Folds text for matching: ASCII lower case, Latin diacritics
+     *        stripped, apostrophes dropped and other punctuation turned into
+     *        single spaces.
+     */
+    static std::string fold(const std::string& text);
+
+    /**
+     * @brief Rebuilds the index for a library; entries are referred to by GameId.
+     */
+    void build(const GameCatalog& catalog);
+
+    /**
+     * @brief Drops the index and the search history.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of indexed entries.
+     */
+    size_t size() const { return keyOffsets.empty() ? 0 : keyOffsets.size() - 1; }
+
+    /**
+     * @brief Finds the entries matching a query.
+     *
+     * @param query Raw query text; it is folded before matching.
+     * @return Ascending entry positions. An empty query matches everything.
+     *         Valid until the next call to search(), build() or clear().
+     */
+    const std::vector<uint32_t>& search(const std::string& query);
+
+    /**
+     * @brief Returns the first entry whose title starts with a letter or digit, or -1.
+     */
+    int firstWithInitial(char initial) const;
+
+    /**
+     * @brief Returns the next entry after position whose title starts with initial,
+     *        wrapping around to the first one, or -1 if there is none.
+     */
+    int nextWithInitial(char initial, int position) const;
+
+    /**
+     * @brief Returns the duration of the last search() call in milliseconds.
+     */
+    double getLastSearchMs() const { return lastSearchMs; }
+
+    /**
+     * @brief Returns the approximate heap footprint of the index in bytes.
+     */
+    size_t memoryBytes() const;
+
+private:
+    static const int INITIAL_SLOTS = 36;  ///< a-z then 0-9.
+    static const size_t MAX_HISTORY = 32;
+    static const size_t MAX_GRAM = 3;
+
+    struct Step {
+        std::string query;             ///< Folded query.
+        std::vector<uint32_t> matches;
+    };
+
+    std::string keys;                   ///< Folded "title filename" of every entry, back to back.
+    std::vector<uint32_t> keyOffsets;   ///< Start of each key in keys, plus the end offset.
+    std::unordered_map<uint32_t, std::vector<uint32_t>> grams;  ///< Ascending postings per 1-3 byte gram.
+    std::array<std::vector<uint32_t>, INITIAL_SLOTS> initials;
+    std::vector<uint32_t> everything;   ///< Result of the empty query.
+    std::vector<Step> history;          ///< Results for each prefix of the current query.
+    double lastSearchMs = 0.0;
+
+    static int initialSlot(char c);
+    bool matchesAll(uint32_t entry, const std::vector<std::string>& terms) const;
+    const std::vector<uint32_t>* smallestPostings(const std::vector<std::string>& terms) const;
+};
@@ -0,0 +1,70 @@
+/**
+ * @file ui_layout.cpp
+ * @brief Computes the UILayout for a drawable size and scale.
+ */
+
+#include "ui_layout.h"
+#include <algorithm>
+
+namespace {
+
+// Base geometry in layout units (pixels of the original 800x600 design)
+const float FONT_SIZE = 18.0f;
+const float ITEM_HEIGHT = 140.0f;
+const float ITEM_PADDING = 20.0f;
+const float SELECTION_INSET = 5.0f;
+const float COVER_SIZE = 100.0f;
+const float TEXT_X = 130.0f;
+const float DETAILS_Y = 25.0f;
+const float DESCRIPTION_Y = 50.0f;
+const float DESCRIPTION_HEIGHT = 40.0f;
+const float LINE_HEIGHT = 25.0f;
+const float GRID_GAP = 12.0f;
+const float STATUS_HEIGHT = 40.0f;
+const float SEARCH_BAR_HEIGHT = 36.0f;
+const float TEXT_INSET = 8.0f;
+const float MARGIN = 10.0f;
+const float DETAIL_INSET = 30.0f;
+const float DETAIL_COVER_SIZE = 180.0f;
+const float DETAIL_THUMB_SIZE = 90.0f;
+
+} // namespace
+
+UILayout UILayout::compute(int width, int height, float scale, float pixelRatio) {
+    UILayout layout;
+    layout.width = std::max(1, width);
+    layout.height = std::max(1, height);
+    layout.scale = std::max(0.25f, scale);
+    layout.pixelRatio = std::max(0.25f, pixelRatio);
+    layout.fontSize = std::max(6, layout.px(FONT_SIZE));
+
+    layout.itemHeight = layout.px(ITEM_HEIGHT);
+    layout.itemPadding = layout.px(ITEM_PADDING);
+    layout.itemPitch = layout.itemHeight + layout.itemPadding;
+    layout.selectionInset = layout.px(SELECTION_INSET);
+    layout.coverSize = layout.px(COVER_SIZE);
+    layout.textX = layout.px(TEXT_X);
+    layout.detailsY = layout.px(DETAILS_Y);
+    layout.descriptionY = layout.px(DESCRIPTION_Y);
+    layout.descriptionHeight = layout.px(DESCRIPTION_HEIGHT);
+    layout.lineHeight = layout.px(LINE_HEIGHT);
+
+    // Descriptions take whatever width is left, so wide screens wrap less
+    layout.descriptionWidth = std::max(layout.px(60.0f), layout.width - layout.textX - layout.itemPadding);
+
+    layout.gridGap = layout.px(GRID_GAP);
+    layout.statusHeight = layout.px(STATUS_HEIGHT);
+    layout.gridViewHeight = std::max(1, layout.height - layout.statusHeight);
+    layout.searchBarHeight = layout.px(SEARCH_BAR_HEIGHT);
+    layout.textInset = layout.px(TEXT_INSET);
+    layout.margin = layout.px(MARGIN);
+
+    const int detailInset = layout.px(DETAIL_INSET);
+    layout.detailX = detailInset;
+    layout.detailY = detailInset;
+    layout.detailWidth = std::max(1, layout.width - 2 * detailInset);
+    layout.detailHeight = std::max(1, layout.height - 2 * detailInset);
+    layout.detailCoverSize = std::min(layout.px(DETAIL_COVER_SIZE), layout.detailWidth / 3);
+    layout.detailThumbSize = layout.px(DETAIL_THUMB_SIZE);
+    return layout;
+}
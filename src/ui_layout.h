@@ -0,0 +1,72 @@
+/**
+ * @file ui_layout.h
+ * @brief Declares UILayout, the resolution-independent geometry of the launcher screens.
+ *
+ * Every element is specified in layout units, the pixels of the original
+ * 800x600 design, and converted to drawable pixels with one scale factor
+ * that combines HiDPI backing stores, display DPI and a user preference.
+ * The result only depends on the drawable size and the scale, so it is
+ * computed when either changes and read as plain fields every frame.
+ */
+
+#pragma once
+
+/**
+ * @brief Geometry of the list view, grid view and overlays in drawable pixels.
+ */
+struct UILayout {
+    int width = 0;            ///< Drawable width in pixels.
+    int height = 0;           ///< Drawable height in pixels.
+    float scale = 1.0f;       ///< Drawable pixels per layout unit.
+    float pixelRatio = 1.0f;  ///< Drawable pixels per window coordinate (2 on Retina).
+    int fontSize = 0;         ///< Point size of the UI font at this scale.
+
+    // List rows
+    int itemHeight = 0;        ///< Height of a row's content.
+    int itemPadding = 0;       ///< Gap above each row and around its edges.
+    int itemPitch = 0;         ///< Distance between the tops of consecutive rows.
+    int selectionInset = 0;    ///< How far the selection highlight extends past a row.
+    int coverSize = 0;         ///< Edge length of a row's cover.
+    int textX = 0;             ///< Left edge of the title, details and description.
+    int detailsY = 0;          ///< Offset of the details line below the title.
+    int descriptionY = 0;      ///< Offset of the description below the title.
+    int descriptionWidth = 0;  ///< Wrap width of the description.
+    int descriptionHeight = 0;
+    int lineHeight = 0;        ///< Distance between description baselines.
+
+    // Grid and overlays
+    int gridGap = 0;           ///< Space between cover tiles.
+    int statusHeight = 0;      ///< Height of the grid's status bar.
+    int gridViewHeight = 0;    ///< Height available to tiles above the status bar.
+    int searchBarHeight = 0;
+    int textInset = 0;         ///< Vertical inset of text in bars.
+    int margin = 0;            ///< Distance of floating panels from the window edge.
+
+    // Detail pane, centered over either view
+    int detailX = 0;
+    int detailY = 0;
+    int detailWidth = 0;
+    int detailHeight = 0;
+    int detailCoverSize = 0;   ///< Edge length of the large cover.
+    int detailThumbSize = 0;   ///< Edge length of screenshot and artwork thumbnails.
+
+    /**
+     * @brief Computes the layout for a drawable size.
+     *
+     * @param width Drawable width in pixels.
+     * @param height Drawable height in pixels.
+     * @param scale Drawable pixels per layout unit.
+     * @param pixelRatio Drawable pixels per window coordinate.
+     */
+    static UILayout compute(int width, int height, float scale, float pixelRatio);
+
+    /**
+     * @brief Converts layout units to drawable pixels.
+     */
+    int px(float units) const { return static_cast<int>(units * scale + 0.5f); }
+
+    bool sameSize(const UILayout& other) const {
+        return width == other.width && height == other.height && scale == other.scale &&
+               pixelRatio == other.pixelRatio;
+    }
+};
@@ -0,0 +1,95 @@
+/**
+ * @file pack_assets.cpp
+ * @brief Build-time tool that writes the launcher's asset pack.
+ *
+ * Bundles the UI font, the placeholder cover (decoded to ARGB8888 so the
+ * launcher never runs a PNG decoder for it) and glyph atlases for the given
+ * font sizes into one file that the launcher memory-maps at startup.
+ *
+ * Usage: pack_assets OUTPUT FONT.ttf PLACEHOLDER.png SIZE...
+ */
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "asset_pack.h"
+#include "glyph_atlas.h"
+
+namespace {
+
+/**
+ * @brief Reads a whole file into memory.
+ */
+bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot read " << path << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        std::cerr << "Usage: " << argv[0] << " OUTPUT FONT.ttf PLACEHOLDER.png SIZE..." << std::endl;
+        return 1;
+    }
+    const std::string output = argv[1];
+    const std::string fontPath = argv[2];
+    const std::string placeholderPath = argv[3];
+
+    if (TTF_Init() < 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::cerr << "Failed to initialize SDL_ttf/SDL_image: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    std::vector<AssetPack::Entry> entries;
+
+    AssetPack::Entry font{AssetPack::FONT, {}};
+    if (!readFile(fontPath, font.data)) {
+        return 1;
+    }
+
+    SDL_Surface* loaded = IMG_Load(placeholderPath.c_str());
+    SDL_Surface* placeholder = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+    if (loaded) SDL_FreeSurface(loaded);
+    if (!placeholder) {
+        std::cerr << "Cannot decode " << placeholderPath << ": " << IMG_GetError() << std::endl;
+        return 1;
+    }
+    entries.push_back({AssetPack::PLACEHOLDER, AssetPack::encodeImage(placeholder)});
+    SDL_FreeSurface(placeholder);
+
+    for (int i = 4; i < argc; ++i) {
+        int size = std::atoi(argv[i]);
+        TTF_Font* sized = size > 0 ? TTF_OpenFont(fontPath.c_str(), size) : nullptr;
+        if (!sized) {
+            std::cerr << "Cannot open " << fontPath << " at size " << argv[i] << ": " << TTF_GetError() << std::endl;
+            return 1;
+        }
+        std::vector<uint8_t> atlas = GlyphAtlas::bake(sized, size);
+        TTF_CloseFont(sized);
+        if (atlas.empty()) {
+            return 1;
+        }
+        entries.push_back({GlyphAtlas::entryName(size), std::move(atlas)});
+    }
+    entries.push_back(std::move(font));
+
+    if (!AssetPack::write(output, entries)) {
+        return 1;
+    }
+
+    IMG_Quit();
+    TTF_Quit();
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file stub_emulator.cpp
+ * @brief Stand-in emulator that speaks the launcher's control protocol, for measuring launches.
+ *
+ * It pays a fixed startup cost, as a real emulator does for dynamic
+ * linking, video setup and config parsing, then loads a ROM, reports its
+ * first frame and "plays" for a while before exiting.
+ *
+ * With --control-fd=N it reports "frame" on descriptor N once the first
+ * frame is up. Started without a ROM it is a warm process: it finishes
+ * its startup, then waits on N for "load PATH" and only then loads it.
+ *
+ * Environment: STUB_STARTUP_MS (default 150) and STUB_PLAY_MS (default 2000).
+ *
+ * Usage: stub_emulator [--control-fd=N] [ROM]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Reads a duration in milliseconds from an environment variable.
+ */
+int envMillis(const char* name, int fallback) {
+    const char* value = std::getenv(name);
+    return value ? std::atoi(value) : fallback;
+}
+
+/**
+ * @brief Reads one newline-terminated line from a descriptor.
+ * @return false on end of file or error.
+ */
+bool readLine(int fd, std::string& line) {
+    line.clear();
+    char c;
+    while (true) {
+        ssize_t n = read(fd, &c, 1);
+        if (n <= 0) return false;
+        if (c == '\n') return true;
+        line += c;
+    }
+}
+
+/**
+ * @brief Sends a message to the launcher, if it is listening.
+ */
+void report(int fd, const std::string& message) {
+    if (fd < 0) return;
+    std::string line = message + "\n";
+    send(fd, line.data(), line.size(), MSG_NOSIGNAL);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int control = -1;
+    std::string rom;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--control-fd=", 13) == 0) {
+            control = std::atoi(argv[i] + 13);
+        } else {
+            rom = argv[i];
+        }
+    }
+    if (rom.empty() && control < 0) {
+        std::cerr << "Usage: " << argv[0] << " [--control-fd=N] [ROM]" << std::endl;
+        return 2;
+    }
+
+    // Startup: what a warm process has already paid by the time a ROM is chosen
+    std::this_thread::sleep_for(std::chrono::milliseconds(envMillis("STUB_STARTUP_MS", 150)));
+
+    if (rom.empty()) {
+        std::string command;
+        if (!readLine(control, command) || command.compare(0, 5, "load ") != 0) {
+            return 0;  // The launcher closed the pool
+        }
+        rom = command.substr(5);
+    }
+
+    std::ifstream in(rom, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!in || data.size() < 16 || std::memcmp(data.data(), "NES\x1A", 4) != 0) {
+        report(control, "error not an iNES ROM: " + rom);
+        std::cerr << "Not an iNES ROM: " << rom << std::endl;
+        return 1;
+    }
+
+    report(control, "frame");
+    std::cout << "stub_emulator: running " << rom << std::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(envMillis("STUB_PLAY_MS", 2000)));
+    return 0;
+}